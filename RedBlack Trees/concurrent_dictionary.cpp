@@ -0,0 +1,49 @@
+#include "concurrent_dictionary.h"
+#include <thread>
+using namespace std;
+
+ConcurrentDictionary::ConcurrentDictionary(const vector<string>& words) : readIndex(0), readersLeft(0), readersRight(0) {
+    trees[0].build(words);
+    trees[1].build(words);
+}
+
+atomic<int>& ConcurrentDictionary::readers(int index) {
+    return index == 0 ? readersLeft : readersRight;
+}
+
+bool ConcurrentDictionary::search(const string& word) {
+    while (true) {
+        int index = readIndex.load();
+        readers(index).fetch_add(1);
+        // the writer may have switched copies between the load and the increment, and may already have seen no
+        // readers in this one, so it only counts as entered if readIndex still points at it (all seq_cst)
+        if (readIndex.load() == index) {
+            bool found = trees[index].search(word);
+            readers(index).fetch_sub(1);
+            return found;
+        }
+        readers(index).fetch_sub(1);
+    }
+}
+
+bool ConcurrentDictionary::insert(const string& word) {
+    lock_guard<mutex> lock(writerMutex);
+    int active = readIndex.load();
+    int inactive = 1 - active;
+
+    // no reader is inside the inactive copy, the last insert waited them out
+    if (!trees[inactive].insert(word))
+        return false;
+    readIndex.store(inactive);
+
+    // new readers go to the updated copy, the ones that started before the switch finish their search first
+    while (readers(active).load() != 0)
+        this_thread::yield();
+    trees[active].insert(word);
+    return true;
+}
+
+int ConcurrentDictionary::size() {
+    lock_guard<mutex> lock(writerMutex);
+    return trees[readIndex.load()].size();
+}
@@ -0,0 +1,35 @@
+#ifndef CONCURRENT_DICTIONARY_H
+#define CONCURRENT_DICTIONARY_H
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "red_black_tree.h"
+
+// A dictionary any number of threads can search while one thread at a time inserts (left-right scheme).
+// It keeps two copies of the tree: readers use the one readIndex points at and never wait, the writer inserts into
+// the other one, switches readers over to it, waits for the readers still in the old copy to leave and inserts there
+// too. Every word is stored twice, in exchange searches are plain tree searches with two atomic counter updates
+class ConcurrentDictionary {
+private:
+    RedBlackTree trees[2];
+    std::atomic<int> readIndex;
+    // readers inside each copy, on separate cache lines so the two counters do not share one
+    alignas(64) std::atomic<int> readersLeft;
+    alignas(64) std::atomic<int> readersRight;
+    std::mutex writerMutex;
+
+    std::atomic<int>& readers(int index);
+
+public:
+    explicit ConcurrentDictionary(const std::vector<std::string>& words);
+
+    // safe from any number of threads at once, including while insert() runs
+    bool search(const std::string& word);
+    // false if the word is already there, inserts from several threads are applied one after the other
+    bool insert(const std::string& word);
+    int size();
+};
+
+#endif //CONCURRENT_DICTIONARY_H
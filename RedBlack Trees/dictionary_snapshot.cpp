@@ -0,0 +1,243 @@
+#include "dictionary_snapshot.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SNAPSHOT_MMAP
+#endif
+
+using namespace std;
+
+MappedSnapshot::MappedSnapshot() : address(nullptr), length(0) {}
+
+MappedSnapshot::~MappedSnapshot() {
+    close();
+}
+
+#ifdef SNAPSHOT_MMAP
+bool MappedSnapshot::open(const string& path) {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t) info.st_size < sizeof(SnapshotHeader)) {
+        ::close(fd);
+        return false;
+    }
+
+    void* mapping = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping keeps the file open
+    ::close(fd);
+    if (mapping == MAP_FAILED) return false;
+    address = mapping;
+    length = info.st_size;
+    // the arrays are read front to back once
+    madvise(address, length, MADV_SEQUENTIAL);
+
+    const SnapshotHeader& h = header();
+    size_t expected = sizeof(SnapshotHeader) + h.nodeCount * sizeof(Node) + h.freeCount * sizeof(NodeIndex) + h.stringBytes;
+    if (memcmp(h.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0 || h.nodeSize != sizeof(Node) || h.nodeCount == 0 ||
+        expected != length) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void MappedSnapshot::close() {
+    if (address) munmap(address, length);
+    address = nullptr;
+    length = 0;
+}
+#else
+bool MappedSnapshot::open(const string& path) {
+    return false;
+}
+
+void MappedSnapshot::close() {}
+#endif
+
+FileStamp fileStamp(const string& path) {
+    error_code error;
+    uint64_t size = filesystem::file_size(path, error);
+    if (error) return {0, 0};
+    auto modified = filesystem::last_write_time(path, error);
+    if (error) return {0, 0};
+    return {size, (int64_t) modified.time_since_epoch().count()};
+}
+
+#ifdef SNAPSHOT_MMAP
+bool syncFile(const string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    bool synced = fsync(fd) == 0;
+    ::close(fd);
+    return synced;
+}
+#else
+// no fsync, the flush before is all there is
+bool syncFile(const string& path) {
+    return true;
+}
+#endif
+
+bool syncParentDirectory(const string& path) {
+    filesystem::path parent = filesystem::path(path).parent_path();
+    return syncFile(parent.empty() ? "." : parent.string());
+}
+
+const SnapshotHeader& MappedSnapshot::header() const {
+    return *(const SnapshotHeader*) address;
+}
+
+// the mapping starts on a page and the header is a multiple of the 8 byte alignment of Node
+static_assert(sizeof(SnapshotHeader) % alignof(Node) == 0);
+
+const Node* MappedSnapshot::nodes() const {
+    return (const Node*) ((const char*) address + sizeof(SnapshotHeader));
+}
+
+const NodeIndex* MappedSnapshot::freeList() const {
+    return (const NodeIndex*) (nodes() + header().nodeCount);
+}
+
+const char* MappedSnapshot::strings() const {
+    return (const char*) (freeList() + header().freeCount);
+}
+
+bool writeSnapshotFile(const string& path, const SnapshotHeader& header, const Node nodes[],
+                       const NodeIndex freeList[], const char strings[]) {
+    string temporary = path + ".tmp";
+    {
+        ofstream file(temporary, ios::binary | ios::trunc);
+        if (!file.is_open()) {
+            cerr << "Error: Could not open file '" << temporary << "'" << endl;
+            return false;
+        }
+        file.write((const char*) &header, sizeof(header));
+        file.write((const char*) nodes, header.nodeCount * sizeof(Node));
+        file.write((const char*) freeList, header.freeCount * sizeof(NodeIndex));
+        file.write(strings, header.stringBytes);
+        if (!file.flush()) {
+            cerr << "Error: Could not write file '" << temporary << "'" << endl;
+            return false;
+        }
+    }
+    // the data has to be on the disk before the rename is, or a power loss can leave an empty snapshot in its place
+    if (!syncFile(temporary)) {
+        cerr << "Error: Could not sync file '" << temporary << "'" << endl;
+        return false;
+    }
+
+    error_code error;
+    filesystem::rename(temporary, path, error);
+    if (error) {
+        cerr << "Error: Could not replace file '" << path << "'" << endl;
+        return false;
+    }
+    syncParentDirectory(path);
+    return true;
+}
+
+WriteAheadLog::WriteAheadLog(const string& path) : path(path), recordCount(0) {}
+
+int WriteAheadLog::replay(const function<void(const string&, bool)>& apply) {
+    ifstream log(path, ios::binary);
+    if (!log.is_open()) return 0;
+
+    int replayed = 0;
+    size_t complete = 0;
+    uint16_t length;
+    string word;
+    while (log.read((char*) &length, sizeof(length))) {
+        // an empty record marks the next one as removed
+        bool removal = length == 0;
+        if (removal && !log.read((char*) &length, sizeof(length))) break;
+        word.resize(length);
+        if (!log.read(word.data(), length)) break;
+        apply(word, removal);
+        replayed++;
+        complete += (removal ? 2 : 1) * sizeof(length) + length;
+    }
+    log.close();
+
+    error_code error;
+    if (filesystem::file_size(path, error) > complete && !error)
+        filesystem::resize_file(path, complete, error);
+    recordCount += replayed;
+    return replayed;
+}
+
+// a file that could not be opened fails the flush
+void WriteAheadLog::openForAppend() {
+    if (!file.is_open()) {
+        file.open(path, ios::binary | ios::app);
+        // the log may have just been created
+        if (file.is_open()) syncParentDirectory(path);
+    }
+}
+
+void WriteAheadLog::writeRecord(const string& word) {
+    uint16_t length = (uint16_t) word.size();
+    file.write((const char*) &length, sizeof(length));
+    file.write(word.data(), length);
+}
+
+// the flush only hands the records to the OS, which survives the program dying but not the machine
+bool WriteAheadLog::flush() {
+    if (!file.flush()) {
+        cerr << "Error: Could not write file '" << path << "'" << endl;
+        return false;
+    }
+    if (!syncFile(path)) {
+        cerr << "Error: Could not sync file '" << path << "'" << endl;
+        return false;
+    }
+    return true;
+}
+
+bool WriteAheadLog::append(const string& word) {
+    if (word.empty() || word.size() > UINT16_MAX) return false;
+    openForAppend();
+    writeRecord(word);
+    if (!flush()) return false;
+    recordCount++;
+    return true;
+}
+
+bool WriteAheadLog::appendRemovals(const vector<string>& words) {
+    for (const string& word : words) {
+        if (word.size() > UINT16_MAX) return false;
+    }
+    openForAppend();
+    for (const string& word : words) {
+        writeRecord("");
+        writeRecord(word);
+    }
+    if (!flush()) return false;
+    recordCount += (int) words.size();
+    return true;
+}
+
+bool WriteAheadLog::clear() {
+    if (file.is_open())
+        file.close();
+    ofstream truncate(path, ios::binary | ios::trunc);
+    if (!truncate.is_open()) {
+        cerr << "Error: Could not open file '" << path << "'" << endl;
+        return false;
+    }
+    recordCount = 0;
+    return true;
+}
+
+int WriteAheadLog::records() {
+    return recordCount;
+}
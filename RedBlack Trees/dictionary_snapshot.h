@@ -0,0 +1,102 @@
+#ifndef DICTIONARY_SNAPSHOT_H
+#define DICTIONARY_SNAPSHOT_H
+
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+#include "red_black_tree.h"
+
+const char SNAPSHOT_MAGIC[8] = {'R', 'B', 'S', 'N', 'A', 'P', '3', '\0'};
+
+// A snapshot file is this header followed by the node array of the pool (nil first), its free list and its string
+// blob, all exactly as they are in memory, so loading one is copying three arrays instead of building a tree
+struct SnapshotHeader {
+    char magic[8];
+    // sizeof(Node) of the program that wrote it, a snapshot with another node layout is rejected
+    uint32_t nodeSize;
+    NodeIndex root;
+    uint32_t treeSize;
+    uint32_t freeCount;
+    uint64_t nodeCount;
+    uint64_t stringBytes;
+    // size and modification time of the file the words came from when the snapshot was written, a snapshot of a
+    // file that was edited since is out of date
+    uint64_t sourceSize;
+    int64_t sourceModified;
+};
+
+// size and modification time of a file, all 0 if it does not exist
+struct FileStamp {
+    uint64_t size;
+    int64_t modified;
+};
+
+FileStamp fileStamp(const std::string& path);
+
+// fsync of a file or a directory (after a rename in it), so what was written survives a power loss and not only a
+// crash of the program, false if it could not be opened or synced
+bool syncFile(const std::string& path);
+// syncs the directory a file is in, which makes a rename into it durable
+bool syncParentDirectory(const std::string& path);
+
+// A snapshot file mapped read only, the arrays point into the mapping until close()
+class MappedSnapshot {
+private:
+    void* address;
+    size_t length;
+
+public:
+    MappedSnapshot();
+    ~MappedSnapshot();
+
+    MappedSnapshot(const MappedSnapshot&) = delete;
+    MappedSnapshot& operator=(const MappedSnapshot&) = delete;
+
+    // false if the file is missing or is not a complete snapshot with this node layout
+    bool open(const std::string& path);
+    void close();
+
+    const SnapshotHeader& header() const;
+    const Node* nodes() const;
+    const NodeIndex* freeList() const;
+    const char* strings() const;
+};
+
+// writes path + ".tmp", syncs it and renames it over path, so a crash or power loss never leaves a half written
+// snapshot behind
+bool writeSnapshotFile(const std::string& path, const SnapshotHeader& header, const Node nodes[],
+                       const NodeIndex freeList[], const char strings[]);
+
+// Append only log of the words inserted and removed since the last snapshot, a record is the length of the word
+// (uint16) followed by its bytes, flushed and synced to the disk as soon as it is written. A removal is an empty record
+// followed by the word
+// (a tombstone), so logs written before removals existed read the same
+class WriteAheadLog {
+private:
+    std::string path;
+    std::ofstream file;
+    int recordCount;
+
+    void openForAppend();
+    void writeRecord(const std::string& word);
+    bool flush();
+
+public:
+    explicit WriteAheadLog(const std::string& path);
+
+    // calls apply on every word in the log in order, removal set for tombstones, and returns how many there were
+    // a record cut short at the end (the program died while appending it) is dropped from the file
+    int replay(const std::function<void(const std::string& word, bool removal)>& apply);
+    // false for an empty word, its record would read as a tombstone
+    bool append(const std::string& word);
+    // one tombstone per word, flushed and synced once for the whole list
+    bool appendRemovals(const std::vector<std::string>& words);
+    // empties the log once its words are in a snapshot
+    bool clear();
+    // records appended or replayed since the log was last cleared
+    int records();
+};
+
+#endif //DICTIONARY_SNAPSHOT_H
@@ -0,0 +1,69 @@
+#include "frozen_dictionary.h"
+#include <cstdint>
+using namespace std;
+
+// prefixes per 64 byte cache line, also how many positions 3 levels below k are next to each other
+const size_t PREFIXES_PER_LINE = 8;
+
+FrozenDictionary::FrozenDictionary(RedBlackTree& tree) {
+    vector<FoldedKey> sorted;
+    for (const string& word : tree.words())
+        sorted.push_back(foldKey(word));
+    count = sorted.size();
+
+    prefixStorage.assign(count + 1 + PREFIXES_PER_LINE, 0);
+    uintptr_t address = (uintptr_t) prefixStorage.data();
+    prefixes = prefixStorage.data() + ((64 - address % 64) % 64) / sizeof(uint64_t);
+    keyOffsets.assign(count + 1, 0);
+    keyLengths.assign(count + 1, 0);
+    removed.assign(count + 1, false);
+    removedCount = 0;
+    fill(sorted, 0, 1);
+}
+
+// in order walk over the implicit tree rooted at k, handing out the sorted keys from next on, returns the next unused
+size_t FrozenDictionary::fill(const vector<FoldedKey>& sorted, size_t next, size_t k) {
+    if (k > count) return next;
+    next = fill(sorted, next, 2 * k);
+    prefixes[k] = sorted[next].prefix;
+    keyOffsets[k] = (uint32_t) keys.size();
+    keyLengths[k] = (uint16_t) sorted[next].folded.size();
+    keys.insert(keys.end(), sorted[next].folded.begin(), sorted[next].folded.end());
+    return fill(sorted, next + 1, 2 * k + 1);
+}
+
+// key compared to position k, <0, 0 or >0
+int FrozenDictionary::compareAt(size_t k, const FoldedKey& key) const {
+    return compareKeys(key, prefixes[k], string_view(keys.data() + keyOffsets[k], keyLengths[k]));
+}
+
+size_t FrozenDictionary::find(const FoldedKey& key) const {
+    size_t k = 1;
+    while (k <= count) {
+        // the 8 great-grandchildren of k, in flight while the next 3 levels are compared
+        if (PREFIXES_PER_LINE * k <= count)
+            __builtin_prefetch(prefixes + PREFIXES_PER_LINE * k);
+        // right when the key is bigger, the position ends up one past the path of the first element >= key
+        k = 2 * k + (compareAt(k, key) > 0 ? 1 : 0);
+    }
+    // drop the trailing right turns (and the left turn before them) to get back to that element, 0 if there is none
+    k >>= __builtin_ffsll(~k);
+    return k != 0 && compareAt(k, key) == 0 ? k : 0;
+}
+
+bool FrozenDictionary::search(const string& word) const {
+    size_t k = find(foldKey(word));
+    return k != 0 && !removed[k];
+}
+
+bool FrozenDictionary::remove(const string& word) {
+    size_t k = find(foldKey(word));
+    if (k == 0 || removed[k]) return false;
+    removed[k] = true;
+    removedCount++;
+    return true;
+}
+
+size_t FrozenDictionary::size() const {
+    return count - removedCount;
+}
@@ -0,0 +1,47 @@
+#ifndef FROZEN_DICTIONARY_H
+#define FROZEN_DICTIONARY_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "red_black_tree.h"
+
+// Read only copy of the words of a tree in Eytzinger (BFS) order: the children of position k are 2k and 2k+1, so a
+// search walks down one array with no pointers and the next 3 levels of a position share one cache line that can be
+// prefetched while the current one is compared. Like the tree it compares folded 8 byte prefixes first, the rest of
+// the folded keys are in a separate blob that is only read when two prefixes are equal
+class FrozenDictionary {
+private:
+    size_t count;
+    // positions 1..count, storage is padded so the array starts on a cache line
+    std::vector<uint64_t> prefixStorage;
+    uint64_t* prefixes;
+    std::vector<uint32_t> keyOffsets;
+    std::vector<uint16_t> keyLengths;
+    std::vector<char> keys;
+    // positions of words removed after freezing, only read once a search has found its word
+    std::vector<bool> removed;
+    size_t removedCount;
+
+    size_t fill(const std::vector<FoldedKey>& sorted, size_t next, size_t k);
+    int compareAt(size_t k, const FoldedKey& key) const;
+    // position of the key, 0 if it is not in the index
+    size_t find(const FoldedKey& key) const;
+
+public:
+    // freezes the words the tree has now, words inserted into the tree later are not in the index, words removed from it
+    // have to be passed on to remove()
+    explicit FrozenDictionary(RedBlackTree& tree);
+
+    FrozenDictionary(const FrozenDictionary&) = delete;
+    FrozenDictionary& operator=(const FrozenDictionary&) = delete;
+
+    bool search(const std::string& word) const;
+    // leaves a tombstone at the position of the word instead of rebuilding, false if it is not in the index
+    bool remove(const std::string& word);
+    // words in the index that were not removed
+    size_t size() const;
+};
+
+#endif //FROZEN_DICTIONARY_H
@@ -1,238 +1,42 @@
 #include <iostream>
 #include <fstream>
 #include <string>
-#include <cstring>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <sstream>
+#include <unordered_set>
+#include <thread>
+#include <filesystem>
+#include "red_black_tree.h"
+#include "concurrent_dictionary.h"
+#include "dictionary_snapshot.h"
+#include "frozen_dictionary.h"
 using namespace std;
 
 const string DICTIONARY_FILE = "../Dictionary.txt";
-enum Color { RED, BLACK };
-
-// Node structure
-struct Node {
-    string data;
-    bool color;
-    Node* left;
-    Node* right;
-    Node* parent;
-
-    Node(string data, Node* nil) : data(data), color(RED), left(nil), right(nil), parent(nil) {}
-};
-
-class RedBlackTree {
-private:
-    Node* root;
-    Node* nil;
-
-    // Rotate left at a particular node
-    void rotateLeft(Node*& root, Node*& z) {
-        Node* rightChild = z->right;
-        z->right = rightChild->left;
-
-        if (rightChild->left != nil)
-            rightChild->left->parent = z;
-
-        rightChild->parent = z->parent;
-
-        if (z->parent == nil)
-            root = rightChild;
-        else if (z == z->parent->left)
-            z->parent->left = rightChild;
-        else
-            z->parent->right = rightChild;
-
-        rightChild->left = z;
-        z->parent = rightChild;
-    }
-
-    // Rotate right at a particular node
-    void rotateRight(Node*& root, Node*& z) {
-        Node* leftChild = z->left;
-        z->left = leftChild->right;
-
-        if (leftChild->right != nil)
-            leftChild->right->parent = z;
-
-        leftChild->parent = z->parent;
-
-        if (z->parent == nil)
-            root = leftChild;
-        else if (z == z->parent->left)
-            z->parent->left = leftChild;
-        else
-            z->parent->right = leftChild;
-
-        leftChild->right = z;
-        z->parent = leftChild;
-    }
-
-    // Fix Red-Black Tree after insertion
-    void fixViolation(Node*& root, Node*& z) {
-        // Base case: If z is root or parent is black, stop
-        if (z == root || z->parent->color == BLACK) {
-            root->color = BLACK;
-            return;
-        }
-
-        Node* parent = z->parent;
-        Node* grandparent = parent->parent;
-
-        // If parent is left child of grandparent
-        if (parent == grandparent->left) {
-            Node* uncle = grandparent->right;
-
-            if (uncle->color == RED) {
-                // Case 1: Recolor parent, uncle, grandparent and recurse up
-                parent->color = BLACK;
-                uncle->color = BLACK;
-                grandparent->color = RED;
-                fixViolation(root, grandparent);
-            } else {
-                // Case 2 & 3 where uncle is black
-                if (z == parent->right) {
-                    // Case 2: z is right child of parent
-                    z = parent;
-                    rotateLeft(root, z);
-                }
-                // Case 3: z is left child of parent
-                parent = z->parent;
-                grandparent = parent->parent;
-                parent->color = BLACK;
-                grandparent->color = RED;
-                rotateRight(root, grandparent);
-            }
-        } else {
-            // Mirror case: If parent is right child of grandparent
-            Node* uncle = grandparent->left;
-
-            if (uncle->color == RED) {
-                // Case 1: Recolor parent,uncle,grandparent and recurse up
-                parent->color = BLACK;
-                uncle->color = BLACK;
-                grandparent->color = RED;
-                fixViolation(root, grandparent);
-            } else {
-                // Case 2 & 3 where uncle is black
-                if (z == parent->left) {
-                    // Case 2: z is left child of parent
-                    z = parent;
-                    rotateRight(root, z);
-                }
-                // Case 3: z is right child of parent
-                parent = z->parent;
-                grandparent = parent->parent;
-                parent->color = BLACK;
-                grandparent->color = RED;
-                rotateLeft(root, grandparent);
-            }
-        }
-
-        root->color = BLACK; // Ensure root is black after fix
-    }
-
-    // Standard BST insert
-    Node* BSTInsert(Node* current, Node* newNode) {
-        if (current == nil)
-            return newNode;
-        //Go left
-        if (strcasecmp(newNode->data.c_str(), current->data.c_str()) < 0) {
-            current->left = BSTInsert(current->left, newNode);
-            current->left->parent = current;
-        }
-        //Go right
-        else if (strcasecmp(newNode->data.c_str(), current->data.c_str()) > 0) {
-            current->right = BSTInsert(current->right, newNode);
-            current->right->parent = current;
-        }
-
-        return current;
-    }
-
-    // Inorder traversal to print sorted words
-    void inorder(Node* node) {
-        if (node == nil) return;
-        inorder(node->left);
-        cout << node->data << " ";
-        inorder(node->right);
-    }
-
-    // Get total height of tree
-    int getHeight(Node* node) {
-        if (node == nil) return 0;
-        return 1 + max(getHeight(node->left), getHeight(node->right));
-    }
-
-    // Get black height (number of black nodes along a path)
-    int getBlackHeight(Node* node) {
-        if (node == nil) return 0;
-        int left = getBlackHeight(node->left);
-        return left + (node->color == BLACK ? 1 : 0);
-    }
-
-    // Count total nodes
-    int countNodes(Node* node) {
-        if (node == nil) return 0;
-        return 1 + countNodes(node->left) + countNodes(node->right);
-    }
-
-    // Search for a word
-    Node* searchNode(Node* node, const string& key) {
-        if (node == nil || strcasecmp(node->data.c_str(), key.c_str()) == 0)
-            return node;
-        //Go left
-        if (strcasecmp(key.c_str(), node->data.c_str()) < 0)
-            return searchNode(node->left, key);
-        //Go right
-        else return searchNode(node->right, key);
-    }
-
-public:
-    RedBlackTree() {
-        // Initialize nil node
-        nil = new Node("", nullptr);
-        nil->color = BLACK;
-        nil->left = nil->right = nil->parent = nil;
-        root = nil;
-    }
-
-    // Insert a new word in RB tree
-    void insert(const string &data) {
-        Node* newNode = new Node(data, nil);
-        root = BSTInsert(root, newNode);
-        fixViolation(root, newNode);
-    }
-
-    // Search for a word
-    bool search(const string& key) {
-        return searchNode(root, key) != nil;
-    }
-
-    // Print tree Height
-    void printTreeHeight() {
-        cout << "Tree Height: " << getHeight(root) << endl;
-    }
-    //Print tree Black Height
-    void printBlackHeight() {
-        cout << "Black Height: " << getBlackHeight(root) << endl;
-    }
-
-    //Print tree size
-    void printTreeSize() {
-        cout << "Tree Size: " << countNodes(root) << endl;
-    }
-
-    //Print sorted tree
-    void printInorder() {
-        cout << "Inorder Traversal: ";
-        inorder(root);
-        cout << endl;
-    }
-};
+// the tree as it was at the last compaction, and the words inserted since
+const string SNAPSHOT_FILE = "../Dictionary.snapshot";
+const string LOG_FILE = "../Dictionary.wal";
+// a log this long is compacted into the snapshot at startup instead of waiting for the exit
+const int LOG_COMPACT_LIMIT = 1000;
+// how long each thread count of the concurrent benchmark runs
+const int CONCURRENT_BENCHMARK_MS = 1000;
+// pause between two inserts of the writer thread in the concurrent benchmark
+const int WRITER_PAUSE_US = 100;
+// times every dictionary word is looked up by the frozen index benchmark
+const int FROZEN_BENCHMARK_ROUNDS = 5;
+// suggestions printed for a prefix
+const int AUTOCOMPLETE_LIMIT = 10;
 
 // Load dictionary from file into Tree
 RedBlackTree loadDictionary(const string &filename) {
     RedBlackTree tree;
     ifstream infile(filename);
     string line;
+    vector<string> words;
 
     if (!infile) {
         cerr << "Error: Could not open file '" << filename << "'" << endl;
@@ -241,56 +45,325 @@ RedBlackTree loadDictionary(const string &filename) {
 
     while (getline(infile, line)) {
         if (!line.empty()) {
-            tree.insert(line);
+            words.push_back(line);
         }
     }
+    tree.build(move(words));
 
     infile.close();
     cout << "Dictionary loaded successfully!\n" << endl;
     tree.printTreeSize();
     tree.printTreeHeight();
     tree.printBlackHeight();
+    tree.printMemoryUsage();
+    return tree;
+}
+// Write the words one per line over the txt file, through a temporary file so a crash leaves the old one
+bool saveDictionary(RedBlackTree &tree, const string &filename) {
+    string temporary = filename + ".tmp";
+    ofstream outfile(temporary);
+    if (!outfile.is_open()) {
+        cerr << "Error: Could not open file '" << temporary << "'" << endl;
+        return false;
+    }
+    // no newline after the last word, like the original file
+    bool first = true;
+    for (string_view word : tree) {
+        if (!first) outfile << "\n";
+        outfile << word;
+        first = false;
+    }
+    outfile.close();
+    // synced like the snapshot, which is only valid for this exact file
+    if (!outfile || !syncFile(temporary)) {
+        cerr << "Error: Could not write file '" << temporary << "'" << endl;
+        return false;
+    }
+    error_code error;
+    filesystem::rename(temporary, filename, error);
+    if (error) {
+        cerr << "Error: Could not write file '" << filename << "'" << endl;
+        return false;
+    }
+    syncParentDirectory(filename);
+    return true;
+}
+
+// Rebuild the tree without the gaps left by removed words, write it to the txt file and save it as the new snapshot,
+// then empty the log
+void compactDictionary(RedBlackTree &tree, WriteAheadLog &log) {
+    tree.build(tree.words());
+    // inserted and removed words only reach the txt file here, until then the log is their only record, so an edit
+    // costs a log record instead of touching the file the snapshot is stamped with
+    if (!saveDictionary(tree, DICTIONARY_FILE))
+        return;
+    if (tree.saveSnapshot(SNAPSHOT_FILE, DICTIONARY_FILE))
+        log.clear();
+}
+
+// Load the snapshot and replay the log on top of it, or import the text file if there is no snapshot yet or the
+// text file was edited after the snapshot was saved
+RedBlackTree openDictionary(WriteAheadLog &log) {
+    auto start = chrono::steady_clock::now();
+    RedBlackTree tree;
+    auto apply = [&](const string &word, bool removal) {
+        if (removal)
+            tree.remove(word);
+        else
+            tree.insert(word);
+    };
+    if (!tree.loadSnapshot(SNAPSHOT_FILE, DICTIONARY_FILE)) {
+        tree = loadDictionary(DICTIONARY_FILE);
+        // the words in the log are not in the text file yet, or were not removed from it
+        log.replay(apply);
+        if (tree.size() > 0)
+            compactDictionary(tree, log);
+        printf("Startup took %.2f ms\n", chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+        return tree;
+    }
+
+    int replayed = log.replay(apply);
+    printf("Dictionary loaded from snapshot in %.2f ms (%d words replayed from the log)\n\n",
+           chrono::duration<double, milli>(chrono::steady_clock::now() - start).count(), replayed);
+    tree.printTreeSize();
+    tree.printTreeHeight();
+    tree.printBlackHeight();
+    tree.printMemoryUsage();
+    if (log.records() >= LOG_COMPACT_LIMIT)
+        compactDictionary(tree, log);
     return tree;
 }
-//Insert a word in tree and update the txt file
-void insertWord(RedBlackTree &tree, const string &word) {
+
+//Insert a word in tree and log it, the txt file is rewritten at the next compaction
+void insertWord(RedBlackTree &tree, WriteAheadLog &log, const string &word) {
     if (tree.search(word)) {
         cout << "ERROR: Word already in the dictionary!" << endl;
         return;
     }
 
     tree.insert(word);
-
-    ofstream outfile(DICTIONARY_FILE, ios::app);
-    if (outfile.is_open()) {
-        outfile << "\n" << word;
+    if (log.append(word))
         cout << "Word inserted successfully!" << endl;
-        outfile.close();
-    } else {
-        cout << "ERROR: Could not open file for writing!" << endl;
+    else
+        cout << "ERROR: Could not log the word, it will be lost on exit!" << endl;
+
+    tree.printTreeSize();
+    tree.printTreeHeight();
+    tree.printBlackHeight();
+}
+//Remove a word from tree and the frozen index and log it, the txt file is rewritten at the next compaction
+void removeWord(RedBlackTree &tree, FrozenDictionary &frozen, WriteAheadLog &log, const string &word) {
+    if (!tree.remove(word)) {
+        cout << "ERROR: Word not in the dictionary!" << endl;
+        return;
     }
+    frozen.remove(word);
+    if (log.appendRemovals({word}))
+        cout << "Word removed successfully!" << endl;
+    else
+        cout << "ERROR: Could not log the removal, the word will be back on the next start!" << endl;
 
     tree.printTreeSize();
     tree.printTreeHeight();
     tree.printBlackHeight();
 }
-//Search for a word in the Tree
-void lookupWord(RedBlackTree &tree, const string &word) {
-    if (tree.search(word)) {
+
+//Remove every word listed in a file (one per line) with one batched removal and one log write
+void removeWordsInFile(RedBlackTree &tree, FrozenDictionary &frozen, WriteAheadLog &log, const string &filename) {
+    ifstream infile(filename);
+    if (!infile) {
+        cerr << "Error: Could not open file '" << filename << "'" << endl;
+        return;
+    }
+    vector<string> words;
+    string line;
+    while (getline(infile, line)) {
+        if (!line.empty())
+            words.push_back(line);
+    }
+
+    auto start = chrono::steady_clock::now();
+    vector<string> removed = tree.removeBatch(words);
+    double removeMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    for (const string &word : removed)
+        frozen.remove(word);
+    if (!removed.empty() && !log.appendRemovals(removed))
+        cout << "ERROR: Could not log the removals, the words will be back on the next start!" << endl;
+
+    printf("%zu words removed, %zu not in the dictionary, in %.3f ms\n", removed.size(), words.size() - removed.size(),
+           removeMs);
+    tree.printTreeSize();
+    tree.printTreeHeight();
+    tree.printBlackHeight();
+}
+
+//Search for a word in the frozen index, or in the Tree if it was inserted after the index was built
+//(removals reach both, so the Tree only has more words than the index if some were inserted since)
+void lookupWord(RedBlackTree &tree, FrozenDictionary &frozen, const string &word) {
+    if (frozen.search(word) || (tree.size() > (int) frozen.size() && tree.search(word))) {
         cout << "YES" << endl;
     } else {
         cout << "NO" << endl;
     }
 }
 
+//Print the first words that start with a prefix and how many there are in total
+void autocompleteWord(RedBlackTree &tree, const string &prefix) {
+    vector<string> matches = tree.prefix(prefix, AUTOCOMPLETE_LIMIT);
+    if (matches.empty()) {
+        cout << "No words start with '" << prefix << "'" << endl;
+        return;
+    }
+    for (const string &word : matches)
+        cout << word << endl;
+    int total = tree.countPrefix(prefix);
+    if (total > (int) matches.size())
+        cout << "... and " << total - (int) matches.size() << " more" << endl;
+}
+
+//Measure lookups/sec from more and more reader threads while a writer keeps inserting
+void benchmarkConcurrentLookups(RedBlackTree &tree) {
+    vector<string> words = tree.words();
+    if (words.empty()) {
+        cout << "ERROR: The dictionary is empty!" << endl;
+        return;
+    }
+    // a copy of the dictionary, the words the writer inserts are not saved
+    ConcurrentDictionary dictionary(words);
+    int maxThreads = max(4, 2 * (int) thread::hardware_concurrency());
+
+    for (int threadCount = 1; threadCount <= maxThreads; threadCount *= 2) {
+        atomic<bool> stop(false);
+        atomic<long long> lookups(0);
+        long long inserts = 0;
+
+        thread writer([&] {
+            while (!stop) {
+                if (dictionary.insert("benchmark" + to_string(threadCount) + "x" + to_string(inserts)))
+                    inserts++;
+                this_thread::sleep_for(chrono::microseconds(WRITER_PAUSE_US));
+            }
+        });
+        vector<thread> readers;
+        for (int t = 0; t < threadCount; t++) {
+            readers.emplace_back([&, t] {
+                minstd_rand engine(t + 1);
+                long long count = 0;
+                while (!stop) {
+                    dictionary.search(words[engine() % words.size()]);
+                    count++;
+                }
+                lookups += count;
+            });
+        }
+
+        this_thread::sleep_for(chrono::milliseconds(CONCURRENT_BENCHMARK_MS));
+        stop = true;
+        for (thread& reader : readers)
+            reader.join();
+        writer.join();
+
+        printf("%d reader threads: %.0f lookups/sec while %lld words were inserted\n", threadCount,
+               lookups * 1000.0 / CONCURRENT_BENCHMARK_MS, inserts);
+    }
+}
+
+//Compare lookups/sec of the Tree and the frozen index on every dictionary word in random order
+void benchmarkFrozenLookups(RedBlackTree &tree, FrozenDictionary &frozen) {
+    vector<string> queries = tree.words();
+    shuffle(queries.begin(), queries.end(), minstd_rand(1));
+
+    // found is compared afterwards, which also keeps the searches from being optimized away
+    auto lookupsPerSecond = [&](auto search, long long &found) {
+        auto start = chrono::steady_clock::now();
+        for (int round = 0; round < FROZEN_BENCHMARK_ROUNDS; round++) {
+            for (const string &query : queries)
+                found += search(query) ? 1 : 0;
+        }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        return queries.size() * FROZEN_BENCHMARK_ROUNDS / seconds;
+    };
+    long long treeFound = 0;
+    long long frozenFound = 0;
+    double treeRate = lookupsPerSecond([&](const string &word) { return tree.search(word); }, treeFound);
+    double frozenRate = lookupsPerSecond([&](const string &word) { return frozen.search(word); }, frozenFound);
+
+    printf("Tree: %.0f lookups/sec\n", treeRate);
+    printf("Frozen index: %.0f lookups/sec (%.2fx)\n", frozenRate, frozenRate / treeRate);
+    // words inserted after the index was built are only in the tree
+    if (frozenFound < treeFound)
+        printf("%lld lookups only the Tree answered\n", treeFound - frozenFound);
+}
+
+// Split text into words: runs of letters, with apostrophes kept inside a word ("loop's") but not around it
+vector<string> tokenizeDocument(const string &text) {
+    vector<string> words;
+    string word;
+    for (size_t i = 0; i <= text.size(); i++) {
+        char c = i < text.size() ? text[i] : ' ';
+        bool inWord = isalpha((unsigned char) c) ||
+                      (c == '\'' && !word.empty() && i + 1 < text.size() && isalpha((unsigned char) text[i + 1]));
+        if (inWord) {
+            word += c;
+        } else if (!word.empty()) {
+            words.push_back(word);
+            word.clear();
+        }
+    }
+    return words;
+}
+
+//Spellcheck a text file with one batched lookup for all of its words
+void checkDocument(RedBlackTree &tree, const string &filename) {
+    ifstream infile(filename);
+    if (!infile) {
+        cerr << "Error: Could not open file '" << filename << "'" << endl;
+        return;
+    }
+    stringstream text;
+    text << infile.rdbuf();
+    vector<string> words = tokenizeDocument(text.str());
+
+    auto start = chrono::steady_clock::now();
+    vector<bool> found = tree.searchBatch(words);
+    double batchMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    // the same lookups one word at a time, for comparison
+    start = chrono::steady_clock::now();
+    int singleFound = 0;
+    for (const string &word : words)
+        singleFound += tree.search(word) ? 1 : 0;
+    double singleMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    unordered_set<string> reported;
+    int misspelled = 0;
+    for (size_t i = 0; i < words.size(); i++) {
+        if (found[i]) continue;
+        misspelled++;
+        if (reported.insert(words[i]).second)
+            cout << words[i] << endl;
+    }
+    printf("%zu words checked, %d not in the dictionary (%zu distinct)\n", words.size(), misspelled, reported.size());
+    printf("Batched lookups took %.3f ms, one at a time %.3f ms (%d found)\n", batchMs, singleMs, singleFound);
+}
+
 int main() {
-    RedBlackTree tree = loadDictionary(DICTIONARY_FILE);
+    WriteAheadLog log(LOG_FILE);
+    RedBlackTree tree = openDictionary(log);
+    // lookups go to a read only copy laid out for searching, inserts still go to the tree
+    FrozenDictionary frozen(tree);
 
     while (true) {
-        cout << "\nChoose an option (1, 2, 3)" << endl;
+        cout << "\nChoose an option (1, 2, 3, 4, 5, 6, 7, 8, 9)" << endl;
         cout << "1. Insert a word" << endl;
-        cout << "2. Lookup a word" << endl;
-        cout << "3. Exit" << endl;
+        cout << "2. Remove a word" << endl;
+        cout << "3. Remove the words listed in a file" << endl;
+        cout << "4. Lookup a word" << endl;
+        cout << "5. Autocomplete a prefix" << endl;
+        cout << "6. Benchmark concurrent lookups" << endl;
+        cout << "7. Benchmark frozen lookups" << endl;
+        cout << "8. Check a document" << endl;
+        cout << "9. Exit" << endl;
 
         cout << "Enter your choice: ";
         int choice;
@@ -301,17 +374,53 @@ int main() {
                 cout << "Enter the word to insert: ";
                 string word;
                 cin >> word;
-                insertWord(tree, word);
+                insertWord(tree, log, word);
                 break;
             }
             case 2: {
+                cout << "Enter the word to remove: ";
+                string word;
+                cin >> word;
+                removeWord(tree, frozen, log, word);
+                break;
+            }
+            case 3: {
+                cout << "Enter the path of the word list: ";
+                string filename;
+                cin >> filename;
+                removeWordsInFile(tree, frozen, log, filename);
+                break;
+            }
+            case 4: {
                 cout << "Enter the word to lookup: ";
                 string word;
                 cin >> word;
-                lookupWord(tree, word);
+                lookupWord(tree, frozen, word);
+                break;
+            }
+            case 5: {
+                cout << "Enter the prefix: ";
+                string prefix;
+                cin >> prefix;
+                autocompleteWord(tree, prefix);
+                break;
+            }
+            case 6:
+                benchmarkConcurrentLookups(tree);
+                break;
+            case 7:
+                benchmarkFrozenLookups(tree, frozen);
+                break;
+            case 8: {
+                cout << "Enter the path of the document: ";
+                string filename;
+                cin >> filename;
+                checkDocument(tree, filename);
                 break;
             }
-            case 3:
+            case 9:
+                if (log.records() > 0)
+                    compactDictionary(tree, log);
                 cout << "Exiting..." << endl;
                 return 0;
             default:
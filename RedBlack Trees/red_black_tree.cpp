@@ -0,0 +1,851 @@
+#include "red_black_tree.h"
+#include "dictionary_snapshot.h"
+#include <iostream>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+using namespace std;
+
+// key of a word that is already folded
+static FoldedKey makeKey(string folded) {
+    FoldedKey key = {0, move(folded)};
+    // shorter words are padded with zero bytes, which sort before every character like the end of a C string
+    for (int i = 0; i < 8; i++)
+        key.prefix = key.prefix << 8 | (i < (int) key.folded.size() ? (unsigned char) key.folded[i] : 0);
+    return key;
+}
+
+FoldedKey foldKey(string_view word) {
+    string folded(word);
+    for (char& c : folded)
+        c = (char) tolower((unsigned char) c);
+    return makeKey(move(folded));
+}
+
+int compareKeys(const FoldedKey& a, uint64_t prefix, string_view folded) {
+    if (a.prefix != prefix)
+        return a.prefix < prefix ? -1 : 1;
+    // the first 8 bytes are equal, string_view::compare is a memcmp plus the lengths
+    return string_view(a.folded).compare(folded);
+}
+
+NodePool::NodePool() : deadBytes(0) {
+    // the nil sentinel, black and pointing to itself
+    nodes.push_back({0, NIL, NIL, NIL, 0, 0, 0, 0, BLACK, 0});
+}
+
+uint32_t NodePool::appendString(string_view s) {
+    uint32_t offset = (uint32_t) strings.size();
+    strings.insert(strings.end(), s.begin(), s.end());
+    return offset;
+}
+
+string_view NodePool::key(NodeIndex index) const {
+    return string_view(strings.data() + nodes[index].keyOffset, nodes[index].length);
+}
+
+string_view NodePool::word(NodeIndex index) const {
+    return string_view(strings.data() + nodes[index].dataOffset, nodes[index].length);
+}
+
+NodeIndex NodePool::allocate(string_view data, const FoldedKey& key) {
+    Node node = {key.prefix, NIL, NIL, NIL, 0, 0, 1, (uint16_t) data.size(), RED, 1};
+    node.keyOffset = appendString(key.folded);
+    node.dataOffset = data == key.folded ? node.keyOffset : appendString(data);
+    if (!freeList.empty()) {
+        NodeIndex index = freeList.back();
+        freeList.pop_back();
+        nodes[index] = node;
+        return index;
+    }
+    nodes.push_back(node);
+    return (NodeIndex) (nodes.size() - 1);
+}
+
+// bytes of the blob a node holds, its key and its spelling if that has capitals
+static size_t stringBytesOf(const Node& node) {
+    return node.dataOffset == node.keyOffset ? node.length : 2 * (size_t) node.length;
+}
+
+void NodePool::release(NodeIndex index) {
+    freeList.push_back(index);
+    deadBytes += stringBytesOf(nodes[index]);
+}
+
+void NodePool::clear() {
+    nodes.resize(1);
+    freeList.clear();
+    strings.clear();
+    deadBytes = 0;
+}
+
+void NodePool::compactStrings() {
+    vector<bool> released(nodes.size(), false);
+    for (NodeIndex index : freeList)
+        released[index] = true;
+
+    vector<char> compacted;
+    compacted.reserve(strings.size() - deadBytes);
+    for (size_t i = 1; i < nodes.size(); i++) {
+        Node& node = nodes[i];
+        if (released[i]) {
+            // nothing of the old blob is left for them to point into
+            node.keyOffset = node.dataOffset = 0;
+            node.length = 0;
+            continue;
+        }
+        uint32_t keyOffset = (uint32_t) compacted.size();
+        compacted.insert(compacted.end(), strings.begin() + node.keyOffset, strings.begin() + node.keyOffset + node.length);
+        if (node.dataOffset != node.keyOffset) {
+            uint32_t dataOffset = (uint32_t) compacted.size();
+            compacted.insert(compacted.end(), strings.begin() + node.dataOffset, strings.begin() + node.dataOffset + node.length);
+            node.dataOffset = dataOffset;
+        } else {
+            node.dataOffset = keyOffset;
+        }
+        node.keyOffset = keyOffset;
+    }
+    strings.swap(compacted);
+    deadBytes = 0;
+}
+
+void NodePool::reserve(size_t count, size_t stringBytes) {
+    nodes.reserve(count + 1);
+    strings.reserve(stringBytes);
+}
+
+bool NodePool::assign(const Node* nodeArray, size_t nodeCount, const NodeIndex* freeNodes, size_t freeCount,
+                      const char* stringBlob, size_t stringBytes) {
+    if (nodeCount == 0 || nodeCount > UINT32_MAX) return false;
+    for (size_t i = 0; i < nodeCount; i++) {
+        const Node& node = nodeArray[i];
+        if (node.left >= nodeCount || node.right >= nodeCount || node.parent >= nodeCount ||
+            node.keyOffset + (size_t) node.length > stringBytes || node.dataOffset + (size_t) node.length > stringBytes)
+            return false;
+    }
+    for (size_t i = 0; i < freeCount; i++) {
+        if (freeNodes[i] == NIL || freeNodes[i] >= nodeCount) return false;
+    }
+
+    nodes.assign(nodeArray, nodeArray + nodeCount);
+    freeList.assign(freeNodes, freeNodes + freeCount);
+    strings.assign(stringBlob, stringBlob + stringBytes);
+    // whatever the nodes in use do not hold is dead
+    vector<bool> released(nodeCount, false);
+    for (NodeIndex index : freeList)
+        released[index] = true;
+    size_t liveBytes = 0;
+    for (size_t i = 1; i < nodeCount; i++) {
+        if (!released[i]) liveBytes += stringBytesOf(nodes[i]);
+    }
+    deadBytes = stringBytes - min(liveBytes, stringBytes);
+    return true;
+}
+
+size_t NodePool::memoryUsage() const {
+    return nodes.capacity() * sizeof(Node) + freeList.capacity() * sizeof(NodeIndex) + strings.capacity();
+}
+
+RedBlackTree::RedBlackTree() : root(NIL), treeSize(0) {}
+
+// Recompute the height and subtree size of a node from its children
+void RedBlackTree::updateNode(NodeIndex node) {
+    pool[node].height = 1 + max(pool[pool[node].left].height, pool[pool[node].right].height);
+    pool[node].size = 1 + pool[pool[node].left].size + pool[pool[node].right].size;
+}
+
+// Rotate left at a particular node
+void RedBlackTree::rotateLeft(NodeIndex z) {
+    NodeIndex rightChild = pool[z].right;
+    pool[z].right = pool[rightChild].left;
+
+    if (pool[rightChild].left != NIL)
+        pool[pool[rightChild].left].parent = z;
+
+    pool[rightChild].parent = pool[z].parent;
+
+    if (pool[z].parent == NIL)
+        root = rightChild;
+    else if (z == pool[pool[z].parent].left)
+        pool[pool[z].parent].left = rightChild;
+    else
+        pool[pool[z].parent].right = rightChild;
+
+    pool[rightChild].left = z;
+    pool[z].parent = rightChild;
+
+    // z is now below rightChild, so it goes first
+    updateNode(z);
+    updateNode(rightChild);
+}
+
+// Rotate right at a particular node
+void RedBlackTree::rotateRight(NodeIndex z) {
+    NodeIndex leftChild = pool[z].left;
+    pool[z].left = pool[leftChild].right;
+
+    if (pool[leftChild].right != NIL)
+        pool[pool[leftChild].right].parent = z;
+
+    pool[leftChild].parent = pool[z].parent;
+
+    if (pool[z].parent == NIL)
+        root = leftChild;
+    else if (z == pool[pool[z].parent].left)
+        pool[pool[z].parent].left = leftChild;
+    else
+        pool[pool[z].parent].right = leftChild;
+
+    pool[leftChild].right = z;
+    pool[z].parent = leftChild;
+
+    updateNode(z);
+    updateNode(leftChild);
+}
+
+// Fix Red-Black Tree after insertion
+void RedBlackTree::fixViolation(NodeIndex z) {
+    // Stop once z is root or its parent is black
+    while (z != root && pool[pool[z].parent].color == RED) {
+        NodeIndex parent = pool[z].parent;
+        NodeIndex grandparent = pool[parent].parent;
+
+        // If parent is left child of grandparent
+        if (parent == pool[grandparent].left) {
+            NodeIndex uncle = pool[grandparent].right;
+
+            if (pool[uncle].color == RED) {
+                // Case 1: Recolor parent, uncle, grandparent and continue from the grandparent
+                pool[parent].color = BLACK;
+                pool[uncle].color = BLACK;
+                pool[grandparent].color = RED;
+                z = grandparent;
+                continue;
+            }
+            // Case 2 & 3 where uncle is black
+            if (z == pool[parent].right) {
+                // Case 2: z is right child of parent
+                z = parent;
+                rotateLeft(z);
+            }
+            // Case 3: z is left child of parent
+            parent = pool[z].parent;
+            grandparent = pool[parent].parent;
+            pool[parent].color = BLACK;
+            pool[grandparent].color = RED;
+            rotateRight(grandparent);
+        } else {
+            // Mirror case: If parent is right child of grandparent
+            NodeIndex uncle = pool[grandparent].left;
+
+            if (pool[uncle].color == RED) {
+                // Case 1: Recolor parent,uncle,grandparent and continue from the grandparent
+                pool[parent].color = BLACK;
+                pool[uncle].color = BLACK;
+                pool[grandparent].color = RED;
+                z = grandparent;
+                continue;
+            }
+            // Case 2 & 3 where uncle is black
+            if (z == pool[parent].left) {
+                // Case 2: z is left child of parent
+                z = parent;
+                rotateRight(z);
+            }
+            // Case 3: z is right child of parent
+            parent = pool[z].parent;
+            grandparent = pool[parent].parent;
+            pool[parent].color = BLACK;
+            pool[grandparent].color = RED;
+            rotateLeft(grandparent);
+        }
+        // the parent of z is black now
+        break;
+    }
+
+    pool[root].color = BLACK; // Ensure root is black after fix
+}
+
+// Balanced subtree over the sorted entries[low..high], the middle word at the top
+// nodes are allocated parent before children, so a search walks forward through the pool
+// depth of the last level of a midpoint split tree of n nodes, the one made red, or -1 if it is full (n is 2^k - 1)
+static int redLevel(int n) {
+    int lastLevel = 0;
+    while ((2 << lastLevel) - 1 < n)
+        lastLevel++;
+    return (2 << lastLevel) - 1 == n ? -1 : lastLevel;
+}
+
+NodeIndex RedBlackTree::buildSubtree(vector<DictionaryEntry>& entries, int low, int high, int depth, int redDepth) {
+    if (low > high) return NIL;
+    int mid = low + (high - low) / 2;
+    NodeIndex node = pool.allocate(entries[mid].word, entries[mid].key);
+    // every empty subtree of a midpoint split is at the same depth or one deeper, so making only the nodes on the
+    // deepest (unfilled) level red gives every path the same number of black nodes without two reds in a row
+    pool[node].color = depth == redDepth ? RED : BLACK;
+
+    NodeIndex left = buildSubtree(entries, low, mid - 1, depth + 1, redDepth);
+    NodeIndex right = buildSubtree(entries, mid + 1, high, depth + 1, redDepth);
+    pool[node].left = left;
+    pool[node].right = right;
+    if (left != NIL) pool[left].parent = node;
+    if (right != NIL) pool[right].parent = node;
+    updateNode(node);
+    return node;
+}
+
+// buildSubtree() over nodes that are already in the pool, in sorted order, only their links and colors change
+NodeIndex RedBlackTree::linkSubtree(const vector<NodeIndex>& nodes, int low, int high, int depth, int redDepth) {
+    if (low > high) return NIL;
+    int mid = low + (high - low) / 2;
+    NodeIndex node = nodes[mid];
+    pool[node].color = depth == redDepth ? RED : BLACK;
+
+    NodeIndex left = linkSubtree(nodes, low, mid - 1, depth + 1, redDepth);
+    NodeIndex right = linkSubtree(nodes, mid + 1, high, depth + 1, redDepth);
+    pool[node].left = left;
+    pool[node].right = right;
+    pool[node].parent = NIL;
+    if (left != NIL) pool[left].parent = node;
+    if (right != NIL) pool[right].parent = node;
+    updateNode(node);
+    return node;
+}
+
+// Get black height (number of black nodes along a path)
+int RedBlackTree::getBlackHeight(NodeIndex node) {
+    int blackHeight = 0;
+    for (; node != NIL; node = pool[node].left)
+        blackHeight += pool[node].color == BLACK ? 1 : 0;
+    return blackHeight;
+}
+
+// Search for a word
+NodeIndex RedBlackTree::searchNode(NodeIndex node, const FoldedKey& key) {
+    while (node != NIL) {
+        int cmp = compareKeys(key, pool[node].prefix, pool.key(node));
+        if (cmp == 0)
+            return node;
+        //Go left or right
+        node = cmp < 0 ? pool[node].left : pool[node].right;
+    }
+    return NIL;
+}
+
+// Insert a new word in RB tree
+bool RedBlackTree::insert(const string& data) {
+    if (data.size() > MAX_WORD_LENGTH)
+        return false;
+    // find the empty spot for the word in one descent, one comparison per level
+    FoldedKey key = foldKey(data);
+    NodeIndex parent = NIL;
+    NodeIndex current = root;
+    int cmp = 0;
+    while (current != NIL) {
+        cmp = compareKeys(key, pool[current].prefix, pool.key(current));
+        if (cmp == 0)
+            return false;
+        parent = current;
+        current = cmp < 0 ? pool[current].left : pool[current].right;
+    }
+
+    NodeIndex newNode = pool.allocate(data, key);
+    pool[newNode].parent = parent;
+    if (parent == NIL)
+        root = newNode;
+    else if (cmp < 0)
+        pool[parent].left = newNode;
+    else
+        pool[parent].right = newNode;
+    treeSize++;
+
+    fixViolation(newNode);
+    // rotations fix the heights and sizes of the nodes they move, the rest of the path up from the old parent
+    // (which stays below every ancestor whose subtree grew) is updated here
+    for (NodeIndex node = parent; node != NIL; node = pool[node].parent)
+        updateNode(node);
+    return true;
+}
+
+// Fix Red-Black Tree after removing a black node
+void RedBlackTree::fixDoubleBlack(NodeIndex x, NodeIndex parent) {
+    // a red x just turns black, a black one moves the missing black up until a sibling can give one
+    while (x != root && pool[x].color == BLACK) {
+        // If x is left child of parent
+        if (x == pool[parent].left) {
+            // the sibling is never nil, its side has at least the black that x is missing
+            NodeIndex sibling = pool[parent].right;
+
+            if (pool[sibling].color == RED) {
+                // Case 1: red sibling, rotate it above the parent so x gets a black sibling
+                pool[sibling].color = BLACK;
+                pool[parent].color = RED;
+                rotateLeft(parent);
+                sibling = pool[parent].right;
+            }
+            if (pool[pool[sibling].left].color == BLACK && pool[pool[sibling].right].color == BLACK) {
+                // Case 2: both nephews black, take a black off the sibling and continue from the parent
+                pool[sibling].color = RED;
+                x = parent;
+                parent = pool[x].parent;
+                continue;
+            }
+            if (pool[pool[sibling].right].color == BLACK) {
+                // Case 3: only the near nephew is red, rotate it into the sibling position
+                pool[pool[sibling].left].color = BLACK;
+                pool[sibling].color = RED;
+                rotateRight(sibling);
+                sibling = pool[parent].right;
+            }
+            // Case 4: far nephew is red, rotating the parent down towards x gives its paths the missing black
+            pool[sibling].color = pool[parent].color;
+            pool[parent].color = BLACK;
+            pool[pool[sibling].right].color = BLACK;
+            rotateLeft(parent);
+        } else {
+            // Mirror case: If x is right child of parent
+            NodeIndex sibling = pool[parent].left;
+
+            if (pool[sibling].color == RED) {
+                // Case 1: red sibling
+                pool[sibling].color = BLACK;
+                pool[parent].color = RED;
+                rotateRight(parent);
+                sibling = pool[parent].left;
+            }
+            if (pool[pool[sibling].left].color == BLACK && pool[pool[sibling].right].color == BLACK) {
+                // Case 2: both nephews black
+                pool[sibling].color = RED;
+                x = parent;
+                parent = pool[x].parent;
+                continue;
+            }
+            if (pool[pool[sibling].left].color == BLACK) {
+                // Case 3: only the near nephew is red
+                pool[pool[sibling].right].color = BLACK;
+                pool[sibling].color = RED;
+                rotateLeft(sibling);
+                sibling = pool[parent].left;
+            }
+            // Case 4: far nephew is red
+            pool[sibling].color = pool[parent].color;
+            pool[parent].color = BLACK;
+            pool[pool[sibling].left].color = BLACK;
+            rotateRight(parent);
+        }
+        // the missing black is restored
+        x = root;
+        break;
+    }
+
+    pool[x].color = BLACK;
+}
+
+// Unlink a node from the tree and give it back to the pool
+void RedBlackTree::removeNode(NodeIndex z) {
+    // a node with two children takes the word of its successor, which has no left child, and the successor is
+    // removed instead, so the node that leaves the tree always has at most one child
+    NodeIndex y = z;
+    if (pool[z].left != NIL && pool[z].right != NIL) {
+        y = pool[z].right;
+        while (pool[y].left != NIL)
+            y = pool[y].left;
+        // swapped rather than copied, so the strings released with y are the ones of the word that is gone
+        pool[z].prefix = pool[y].prefix;
+        swap(pool[z].keyOffset, pool[y].keyOffset);
+        swap(pool[z].dataOffset, pool[y].dataOffset);
+        swap(pool[z].length, pool[y].length);
+    }
+
+    NodeIndex x = pool[y].left != NIL ? pool[y].left : pool[y].right;
+    NodeIndex parent = pool[y].parent;
+    if (x != NIL)
+        pool[x].parent = parent;
+    if (parent == NIL)
+        root = x;
+    else if (y == pool[parent].left)
+        pool[parent].left = x;
+    else
+        pool[parent].right = x;
+    treeSize--;
+
+    if (pool[y].color == BLACK)
+        fixDoubleBlack(x, parent);
+    // like insert, the rotations fix the nodes they move and everything they move ends up above the old parent
+    for (NodeIndex node = parent; node != NIL; node = pool[node].parent)
+        updateNode(node);
+    pool.release(y);
+}
+
+void RedBlackTree::reclaimStrings() {
+    // each compaction is paid for by the removals that left a quarter of the live bytes dead since the last one
+    if (pool.deadStringBytes() * STRING_COMPACT_RATIO > pool.liveStringBytes())
+        pool.compactStrings();
+}
+
+// Remove a word from RB tree
+bool RedBlackTree::remove(const string& word) {
+    NodeIndex node = searchNode(root, foldKey(word));
+    if (node == NIL)
+        return false;
+    removeNode(node);
+    reclaimStrings();
+    return true;
+}
+
+vector<string> RedBlackTree::removeBatch(const vector<string>& words) {
+    vector<FoldedKey> keys;
+    keys.reserve(words.size());
+    for (const string& word : words)
+        keys.push_back(foldKey(word));
+    auto lessKey = [](const FoldedKey& a, const FoldedKey& b) { return compareKeys(a, b.prefix, b.folded) < 0; };
+    auto equalKey = [](const FoldedKey& a, const FoldedKey& b) { return compareKeys(a, b.prefix, b.folded) == 0; };
+    sort(keys.begin(), keys.end(), lessKey);
+    keys.erase(unique(keys.begin(), keys.end(), equalKey), keys.end());
+
+    vector<string> removed;
+    // a remove is a descent and a fixup, about height() steps, a rebuild is a pass over all n nodes
+    if (keys.size() * max(height(), 1) < (size_t) treeSize) {
+        for (const FoldedKey& key : keys) {
+            NodeIndex node = searchNode(root, key);
+            if (node == NIL) continue;
+            removed.emplace_back(pool.word(node));
+            removeNode(node);
+        }
+        reclaimStrings();
+        return removed;
+    }
+
+    // both in sorted order, so one merge finds the nodes that stay, which are then linked into a balanced tree
+    // again the way build() makes one, without copying their words
+    vector<NodeIndex> kept;
+    kept.reserve(treeSize);
+    size_t next = 0;
+    for (Iterator it = begin(); it != end(); ++it) {
+        uint64_t prefix = pool[it.node].prefix;
+        string_view key = pool.key(it.node);
+        while (next < keys.size() && compareKeys(keys[next], prefix, key) < 0)
+            next++;
+        if (next < keys.size() && compareKeys(keys[next], prefix, key) == 0) {
+            removed.emplace_back(*it);
+            // release() leaves the links alone, the walk still goes through them
+            pool.release(it.node);
+        } else {
+            kept.push_back(it.node);
+        }
+    }
+    if (removed.empty())
+        return removed;
+    root = linkSubtree(kept, 0, (int) kept.size() - 1, 0, redLevel((int) kept.size()));
+    if (root != NIL) pool[root].color = BLACK;
+    treeSize = (int) kept.size();
+    reclaimStrings();
+    return removed;
+}
+
+// Search for a word
+bool RedBlackTree::search(const string& key) {
+    return searchNode(root, foldKey(key)) != NIL;
+}
+
+// Search for many words at once, each slot is one lookup part way down the tree (AMAC style: a finished slot starts
+// the next key straight away instead of waiting for the rest of its group)
+vector<bool> RedBlackTree::searchBatch(const vector<string>& keys) {
+    struct Lookup {
+        size_t query;
+        NodeIndex node;
+        FoldedKey key;
+    };
+    vector<bool> found(keys.size(), false);
+    Lookup slots[BATCH_GROUP_SIZE];
+    size_t next = 0;
+    int active = 0;
+
+    auto start = [&](Lookup& slot) {
+        if (next == keys.size()) return false;
+        slot.query = next;
+        slot.key = foldKey(keys[next]);
+        slot.node = root;
+        next++;
+        return true;
+    };
+    for (Lookup& slot : slots) {
+        if (!start(slot)) break;
+        active++;
+    }
+    __builtin_prefetch(&pool[root]);
+
+    while (active > 0) {
+        for (int s = 0; s < active; s++) {
+            Lookup& slot = slots[s];
+            if (slot.node != NIL) {
+                int cmp = compareKeys(slot.key, pool[slot.node].prefix, pool.key(slot.node));
+                if (cmp != 0) {
+                    // one level down, the node is fetched while the other slots take their step
+                    slot.node = cmp < 0 ? pool[slot.node].left : pool[slot.node].right;
+                    __builtin_prefetch(&pool[slot.node]);
+                    continue;
+                }
+                found[slot.query] = true;
+            }
+            // done, take the next key or move the last active slot here
+            if (!start(slot)) {
+                active--;
+                swap(slot, slots[active]);
+                s--;
+            }
+        }
+    }
+    return found;
+}
+
+// Build the tree from a list of words in one pass
+void RedBlackTree::build(vector<string> words) {
+    // every word is folded once here instead of in every comparison of the sort
+    vector<DictionaryEntry> entries;
+    entries.reserve(words.size());
+    size_t stringBytes = 0;
+    for (string& word : words) {
+        if (word.size() > MAX_WORD_LENGTH) continue;
+        FoldedKey key = foldKey(word);
+        // capitalized words need their spelling stored next to the key
+        stringBytes += key.folded == word ? word.size() : 2 * word.size();
+        entries.push_back({move(key), move(word)});
+    }
+    auto lessIgnoringCase = [](const DictionaryEntry& a, const DictionaryEntry& b) {
+        return compareKeys(a.key, b.key.prefix, b.key.folded) < 0;
+    };
+    auto equalIgnoringCase = [](const DictionaryEntry& a, const DictionaryEntry& b) {
+        return compareKeys(a.key, b.key.prefix, b.key.folded) == 0;
+    };
+    if (!is_sorted(entries.begin(), entries.end(), lessIgnoringCase))
+        stable_sort(entries.begin(), entries.end(), lessIgnoringCase);
+    entries.erase(unique(entries.begin(), entries.end(), equalIgnoringCase), entries.end());
+
+    pool.clear();
+    pool.reserve(entries.size(), stringBytes);
+    int n = (int) entries.size();
+    root = buildSubtree(entries, 0, n - 1, 0, redLevel(n));
+    if (root != NIL) pool[root].color = BLACK;
+    treeSize = n;
+}
+
+int RedBlackTree::size() {
+    return treeSize;
+}
+
+int RedBlackTree::height() {
+    return pool[root].height;
+}
+
+vector<string> RedBlackTree::words() {
+    vector<string> sorted;
+    sorted.reserve(treeSize);
+    for (string_view word : *this)
+        sorted.emplace_back(word);
+    return sorted;
+}
+
+// Next node in sorted order: the leftmost node of the right subtree, or else the first ancestor reached from its left
+RedBlackTree::Iterator& RedBlackTree::Iterator::operator++() {
+    const NodePool& nodes = *pool;
+    if (nodes[node].right != NIL) {
+        node = nodes[node].right;
+        while (nodes[node].left != NIL)
+            node = nodes[node].left;
+        return *this;
+    }
+    NodeIndex parent = nodes[node].parent;
+    while (parent != NIL && node == nodes[parent].right) {
+        node = parent;
+        parent = nodes[parent].parent;
+    }
+    node = parent;
+    return *this;
+}
+
+RedBlackTree::Iterator RedBlackTree::Iterator::operator++(int) {
+    Iterator old = *this;
+    ++*this;
+    return old;
+}
+
+RedBlackTree::Iterator RedBlackTree::begin() const {
+    NodeIndex node = root;
+    while (node != NIL && pool[node].left != NIL)
+        node = pool[node].left;
+    return Iterator(&pool, node);
+}
+
+RedBlackTree::Iterator RedBlackTree::end() const {
+    return Iterator(&pool, NIL);
+}
+
+NodeIndex RedBlackTree::boundNode(const FoldedKey& key, bool inclusive) const {
+    NodeIndex bound = NIL;
+    NodeIndex node = root;
+    while (node != NIL) {
+        int cmp = compareKeys(key, pool[node].prefix, pool.key(node));
+        // node is a candidate, look for a smaller one on the left
+        if (cmp < 0 || (cmp == 0 && !inclusive)) {
+            bound = node;
+            node = pool[node].left;
+        } else {
+            node = pool[node].right;
+        }
+    }
+    return bound;
+}
+
+int RedBlackTree::countBelow(const FoldedKey& key, bool inclusive) const {
+    int count = 0;
+    NodeIndex node = root;
+    while (node != NIL) {
+        int cmp = compareKeys(key, pool[node].prefix, pool.key(node));
+        if (cmp < 0 || (cmp == 0 && !inclusive)) {
+            node = pool[node].left;
+        } else {
+            // node and its whole left subtree are below the key
+            count += pool[pool[node].left].size + 1;
+            node = pool[node].right;
+        }
+    }
+    return count;
+}
+
+bool RedBlackTree::prefixEnd(const FoldedKey& prefix, FoldedKey& end) {
+    string folded = prefix.folded;
+    // drop the trailing 0xFF bytes and bump the last byte left, "ab" ends at "ac"
+    while (!folded.empty() && (unsigned char) folded.back() == 0xFF)
+        folded.pop_back();
+    if (folded.empty()) return false;
+    folded.back() = (char) ((unsigned char) folded.back() + 1);
+    // already folded, folding it again could change the bumped byte into another letter
+    end = makeKey(move(folded));
+    return true;
+}
+
+RedBlackTree::Iterator RedBlackTree::lowerBound(const string& word) const {
+    return Iterator(&pool, boundNode(foldKey(word), false));
+}
+
+RedBlackTree::Iterator RedBlackTree::upperBound(const string& word) const {
+    return Iterator(&pool, boundNode(foldKey(word), true));
+}
+
+RedBlackTree::WordRange RedBlackTree::range(const string& lo, const string& hi) const {
+    FoldedKey low = foldKey(lo);
+    FoldedKey high = foldKey(hi);
+    // a reversed range would never reach its end
+    if (compareKeys(low, high.prefix, high.folded) > 0)
+        return {end(), end()};
+    return {Iterator(&pool, boundNode(low, false)), Iterator(&pool, boundNode(high, true))};
+}
+
+vector<string> RedBlackTree::prefix(const string& word, int limit) const {
+    vector<string> matches;
+    FoldedKey key = foldKey(word);
+    for (Iterator it(&pool, boundNode(key, false)); it != end() && (int) matches.size() < limit; ++it) {
+        if (!pool.key(it.node).starts_with(key.folded)) break;
+        matches.emplace_back(*it);
+    }
+    return matches;
+}
+
+int RedBlackTree::rank(const string& word) const {
+    return countBelow(foldKey(word), false);
+}
+
+RedBlackTree::Iterator RedBlackTree::select(int index) const {
+    if (index < 0 || index >= treeSize) return end();
+    NodeIndex node = root;
+    while (node != NIL) {
+        int leftSize = (int) pool[pool[node].left].size;
+        if (index == leftSize) break;
+        if (index < leftSize) {
+            node = pool[node].left;
+        } else {
+            index -= leftSize + 1;
+            node = pool[node].right;
+        }
+    }
+    return Iterator(&pool, node);
+}
+
+int RedBlackTree::countRange(const string& lo, const string& hi) const {
+    FoldedKey low = foldKey(lo);
+    FoldedKey high = foldKey(hi);
+    if (compareKeys(low, high.prefix, high.folded) > 0) return 0;
+    return countBelow(high, true) - countBelow(low, false);
+}
+
+int RedBlackTree::countPrefix(const string& word) const {
+    FoldedKey key = foldKey(word);
+    FoldedKey end;
+    int below = prefixEnd(key, end) ? countBelow(end, false) : treeSize;
+    return below - countBelow(key, false);
+}
+
+bool RedBlackTree::saveSnapshot(const string& path, const string& sourcePath) {
+    // the words of released nodes are not written out
+    if (pool.deadStringBytes() > 0)
+        pool.compactStrings();
+    SnapshotHeader header = {};
+    FileStamp source = fileStamp(sourcePath);
+    header.sourceSize = source.size;
+    header.sourceModified = source.modified;
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.nodeSize = sizeof(Node);
+    header.root = root;
+    header.treeSize = treeSize;
+    header.freeCount = pool.freeNodes().size();
+    header.nodeCount = pool.nodeArray().size();
+    header.stringBytes = pool.stringBlob().size();
+    return writeSnapshotFile(path, header, pool.nodeArray().data(), pool.freeNodes().data(), pool.stringBlob().data());
+}
+
+bool RedBlackTree::loadSnapshot(const string& path, const string& sourcePath) {
+    MappedSnapshot snapshot;
+    if (!snapshot.open(path))
+        return false;
+    const SnapshotHeader& header = snapshot.header();
+    if (header.root >= header.nodeCount)
+        return false;
+    FileStamp source = fileStamp(sourcePath);
+    if (source.size != header.sourceSize || source.modified != header.sourceModified)
+        return false;
+    if (!pool.assign(snapshot.nodes(), header.nodeCount, snapshot.freeList(), header.freeCount, snapshot.strings(),
+                     header.stringBytes))
+        return false;
+    root = header.root;
+    treeSize = header.treeSize;
+    return true;
+}
+
+// Print tree Height
+void RedBlackTree::printTreeHeight() {
+    cout << "Tree Height: " << height() << endl;
+}
+
+//Print tree Black Height
+void RedBlackTree::printBlackHeight() {
+    cout << "Black Height: " << getBlackHeight(root) << endl;
+}
+
+//Print tree size
+void RedBlackTree::printTreeSize() {
+    cout << "Tree Size: " << treeSize << endl;
+}
+
+//Print memory held by the node pool
+void RedBlackTree::printMemoryUsage() {
+    cout << "Node Pool: " << pool.memoryUsage() / 1024 << " KB" << endl;
+}
+
+//Print sorted tree
+void RedBlackTree::printInorder() {
+    cout << "Inorder Traversal: ";
+    for (string_view word : *this)
+        cout << word << " ";
+    cout << endl;
+}
@@ -0,0 +1,227 @@
+#ifndef RED_BLACK_TREE_H
+#define RED_BLACK_TREE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum Color : uint8_t { RED, BLACK };
+
+// nodes refer to each other by their index in the pool instead of a pointer, 4 bytes instead of 8
+typedef uint32_t NodeIndex;
+// index 0 is the nil sentinel of the tree
+const NodeIndex NIL = 0;
+
+// lookups searchBatch() keeps in flight, enough that the other descents cover the cache miss of one
+const int BATCH_GROUP_SIZE = 16;
+
+// longest word a node can hold
+const int MAX_WORD_LENGTH = UINT16_MAX;
+
+// the string blob is compacted once the strings of released nodes are more than 1/STRING_COMPACT_RATIO of the live ones
+const int STRING_COMPACT_RATIO = 4;
+
+// A word folded to lower case the way strcasecmp compares it, plus its first 8 folded bytes as a big endian number,
+// so most comparisons are decided by one integer compare and the rest by one memcmp of the folded strings
+struct FoldedKey {
+    uint64_t prefix;
+    std::string folded;
+};
+
+FoldedKey foldKey(std::string_view word);
+// <0, 0 or >0 like strcasecmp
+int compareKeys(const FoldedKey& a, uint64_t prefix, std::string_view folded);
+
+// Node structure, 40 bytes with the fields a search reads first
+// the strings are kept in the pool, so nodes stay small and a whole tree is two arrays
+struct Node {
+    uint64_t prefix;
+    NodeIndex left;
+    NodeIndex right;
+    NodeIndex parent;
+    // folded word and the word as it was inserted in the string blob of the pool, the same bytes if it has no capitals
+    uint32_t keyOffset;
+    uint32_t dataOffset;
+    // nodes in the subtree rooted here, 0 for nil, so the position of a node is known without walking the tree
+    uint32_t size;
+    uint16_t length;
+    Color color;
+    // nodes on the longest path down to nil, 1 for a leaf and 0 for nil
+    uint8_t height;
+};
+
+// a word and its key, as sorted by build()
+struct DictionaryEntry {
+    FoldedKey key;
+    std::string word;
+};
+
+// All the nodes of one tree in one contiguous array and all their strings in another, so a load is a few vector
+// growths instead of a new per word and everything is freed at once with the tree.
+// Released nodes are kept on a free list and handed out again first, their strings stay in the blob as dead bytes
+// until compactStrings() or clear()
+class NodePool {
+private:
+    std::vector<Node> nodes;
+    std::vector<NodeIndex> freeList;
+    std::vector<char> strings;
+    size_t deadBytes;
+
+    uint32_t appendString(std::string_view s);
+
+public:
+    NodePool();
+
+    // references into the pool are invalidated by allocate(), keep indices across it
+    Node& operator[](NodeIndex index) { return nodes[index]; }
+    const Node& operator[](NodeIndex index) const { return nodes[index]; }
+
+    std::string_view key(NodeIndex index) const;
+    std::string_view word(NodeIndex index) const;
+
+    // the word has to be at most MAX_WORD_LENGTH long
+    NodeIndex allocate(std::string_view data, const FoldedKey& key);
+    // the node has to hold its own strings, they are counted as dead from here on
+    void release(NodeIndex index);
+    // drops every node but the sentinel
+    void clear();
+    // copies the strings of the nodes in use into a new blob without the dead bytes, O(n), offsets change
+    void compactStrings();
+    size_t deadStringBytes() const { return deadBytes; }
+    size_t liveStringBytes() const { return strings.size() - deadBytes; }
+    void reserve(size_t count, size_t stringBytes);
+    size_t memoryUsage() const;
+
+    // the arrays as they are, for snapshots
+    const std::vector<Node>& nodeArray() const { return nodes; }
+    const std::vector<NodeIndex>& freeNodes() const { return freeList; }
+    const std::vector<char>& stringBlob() const { return strings; }
+    // replaces the pool with copies of the arrays, false (pool unchanged) if a link or string is out of range
+    bool assign(const Node* nodeArray, size_t nodeCount, const NodeIndex* freeNodes, size_t freeCount,
+                const char* stringBlob, size_t stringBytes);
+};
+
+class RedBlackTree {
+public:
+    // Walks the words in sorted order one node at a time through the parent links, no stack and no copy of the tree.
+    // Invalidated by insert(), remove() and build()
+    class Iterator {
+    private:
+        const NodePool* pool;
+        NodeIndex node;
+
+        friend class RedBlackTree;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = std::string_view;
+
+        Iterator() : pool(nullptr), node(NIL) {}
+        Iterator(const NodePool* pool, NodeIndex node) : pool(pool), node(node) {}
+
+        // the word as it was inserted
+        std::string_view operator*() const { return pool->word(node); }
+        Iterator& operator++();
+        Iterator operator++(int);
+        bool operator==(const Iterator& other) const { return node == other.node; }
+    };
+
+    // the words from first up to but not including last, for range based for loops
+    struct WordRange {
+        Iterator first;
+        Iterator last;
+
+        Iterator begin() const { return first; }
+        Iterator end() const { return last; }
+    };
+
+private:
+    NodePool pool;
+    NodeIndex root;
+    int treeSize;
+
+    void rotateLeft(NodeIndex z);
+    void rotateRight(NodeIndex z);
+    void updateNode(NodeIndex node);
+    void fixViolation(NodeIndex z);
+    // x took the place of a removed black node and is missing one black on its paths, parent is tracked separately
+    // since x may be nil
+    void fixDoubleBlack(NodeIndex x, NodeIndex parent);
+    void removeNode(NodeIndex z);
+    // compacts the string blob of the pool once enough of it is dead
+    void reclaimStrings();
+    NodeIndex buildSubtree(std::vector<DictionaryEntry>& entries, int low, int high, int depth, int redDepth);
+    NodeIndex linkSubtree(const std::vector<NodeIndex>& nodes, int low, int high, int depth, int redDepth);
+
+    int getBlackHeight(NodeIndex node);
+    NodeIndex searchNode(NodeIndex node, const FoldedKey& key);
+    // first node after the key, or not before it if inclusive is false
+    NodeIndex boundNode(const FoldedKey& key, bool inclusive) const;
+    // words before the key, or not after it if inclusive is true
+    int countBelow(const FoldedKey& key, bool inclusive) const;
+    // the smallest key after every word that starts with the folded prefix, false if there is none (the prefix is
+    // empty or all 0xFF bytes)
+    static bool prefixEnd(const FoldedKey& prefix, FoldedKey& end);
+
+public:
+    RedBlackTree();
+
+    // false if the word is already in the tree or longer than MAX_WORD_LENGTH
+    bool insert(const std::string& data);
+    // false if the word is not in the tree, the node goes back to the pool
+    bool remove(const std::string& word);
+    // removes every word in the list that is in the tree and returns them as they were stored, one remove() per word
+    // for a few words and once that gets more expensive one pass that relinks the rest into a balanced tree
+    std::vector<std::string> removeBatch(const std::vector<std::string>& words);
+    bool search(const std::string& key);
+    // bit i is set if keys[i] is in the tree, the descents of up to BATCH_GROUP_SIZE keys are interleaved one level at
+    // a time and every next node is prefetched, so their memory latency overlaps instead of adding up
+    std::vector<bool> searchBatch(const std::vector<std::string>& keys);
+    // replaces the contents of the tree with the words, sorted and deduplicated ignoring case (the first spelling wins)
+    // the tree is built balanced straight from the sorted words, O(n) after the sort instead of n inserts
+    void build(std::vector<std::string> words);
+
+    int size();
+    int height();
+    // every word in sorted order, as it was inserted
+    std::vector<std::string> words();
+
+    // ordered queries ignore case like search(), the ones that find a position take O(logn) and walking k words from
+    // it O(k) more
+    Iterator begin() const;
+    Iterator end() const;
+    // first word not before / after word
+    Iterator lowerBound(const std::string& word) const;
+    Iterator upperBound(const std::string& word) const;
+    // the words from lo to hi, both included, found lazily as the range is walked
+    WordRange range(const std::string& lo, const std::string& hi) const;
+    // up to limit words that start with word, in sorted order
+    std::vector<std::string> prefix(const std::string& word, int limit) const;
+    // number of words before word, whether it is in the tree or not
+    int rank(const std::string& word) const;
+    // the word with index words before it, end() if index is out of range
+    Iterator select(int index) const;
+    int countRange(const std::string& lo, const std::string& hi) const;
+    int countPrefix(const std::string& word) const;
+
+    // saves the pool as it is in a binary snapshot, see dictionary_snapshot.h
+    // sourcePath is the file the words came from, its size and modification time are saved with them
+    bool saveSnapshot(const std::string& path, const std::string& sourcePath);
+    // replaces the tree with a saved snapshot, false (tree unchanged) if there is none or it is damaged
+    // or if sourcePath was changed after it was saved
+    bool loadSnapshot(const std::string& path, const std::string& sourcePath);
+
+    void printTreeHeight();
+    void printBlackHeight();
+    void printTreeSize();
+    void printMemoryUsage();
+    void printInorder();
+};
+
+#endif //RED_BLACK_TREE_H
@@ -0,0 +1,257 @@
+#include "benchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <random>
+
+using namespace std;
+
+const char* distributionName(InputDistribution distribution) {
+    switch (distribution) {
+        case RANDOM_INPUT: return "random";
+        case SORTED_INPUT: return "sorted";
+        case REVERSED_INPUT: return "reversed";
+        case FEW_UNIQUE_INPUT: return "few-unique";
+        case ORGAN_PIPE_INPUT: return "organ-pipe";
+        case ZIPF_INPUT: return "zipf";
+        case NEARLY_SORTED_INPUT: return "nearly-sorted";
+    }
+    return "unknown";
+}
+
+// the same seed always gives the same input, so every case of a size and distribution sorts identical data
+vector<int> generateInput(InputDistribution distribution, int size, unsigned seed) {
+    mt19937 engine(seed);
+    vector<int> input(size);
+
+    switch (distribution) {
+        case RANDOM_INPUT:
+            // non-negative like rand()
+            for (int i = 0; i < size; i++)
+                input[i] = engine() >> 1;
+            break;
+        case SORTED_INPUT:
+            for (int i = 0; i < size; i++)
+                input[i] = i;
+            break;
+        case REVERSED_INPUT:
+            for (int i = 0; i < size; i++)
+                input[i] = size - i;
+            break;
+        case FEW_UNIQUE_INPUT:
+            for (int i = 0; i < size; i++)
+                input[i] = engine() % FEW_UNIQUE_VALUES;
+            break;
+        case ORGAN_PIPE_INPUT:
+            // ascending to the middle, then descending
+            for (int i = 0; i < size; i++)
+                input[i] = i < size / 2 ? i : size - i;
+            break;
+        case ZIPF_INPUT: {
+            // rank r is drawn with probability proportional to 1/r, found by binary search in the cumulative weights
+            vector<double> cumulative(ZIPF_RANKS);
+            double sum = 0;
+            for (int r = 0; r < ZIPF_RANKS; r++) {
+                sum += 1.0 / (r + 1);
+                cumulative[r] = sum;
+            }
+            uniform_real_distribution<double> uniform(0, sum);
+            for (int i = 0; i < size; i++) {
+                int rank = lower_bound(cumulative.begin(), cumulative.end(), uniform(engine)) - cumulative.begin();
+                input[i] = min(rank, ZIPF_RANKS - 1);
+            }
+            break;
+        }
+        case NEARLY_SORTED_INPUT: {
+            // a sorted snapshot with a few entries changed since, followed by new entries appended out of order
+            int appended = size / NEARLY_SORTED_SPACING;
+            int sorted = size - appended;
+            for (int i = 0; i < sorted; i++)
+                input[i] = i;
+            for (int i = 0; i < sorted / NEARLY_SORTED_SPACING; i++)
+                swap(input[engine() % sorted], input[engine() % sorted]);
+            for (int i = sorted; i < size; i++)
+                input[i] = engine() % size;
+            break;
+        }
+    }
+    return input;
+}
+
+bool shouldRun(const BenchmarkCase& benchmarkCase, InputDistribution distribution, int size) {
+    if (size > benchmarkCase.maxSize) return false;
+    bool duplicateHeavy = distribution == FEW_UNIQUE_INPUT || distribution == ZIPF_INPUT;
+    if (benchmarkCase.quadraticOnDuplicates && duplicateHeavy && size > QUADRATIC_SIZE_LIMIT) return false;
+    return true;
+}
+
+static double runOnce(const BenchmarkCase& benchmarkCase, const vector<int>& input, vector<int>& work) {
+    // copying the input is not part of the measurement
+    copy(input.begin(), input.end(), work.begin());
+    auto start = chrono::steady_clock::now();
+    benchmarkCase.run(work.data(), work.size());
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+// nearest rank percentile of sorted samples
+static double percentile(const vector<double>& samples, double p) {
+    int rank = (int) ceil(p * samples.size());
+    return samples[max(rank, 1) - 1];
+}
+
+BenchmarkResult runBenchmark(const BenchmarkCase& benchmarkCase, const vector<int>& input,
+                             InputDistribution distribution, const BenchmarkOptions& options) {
+    vector<int> work(input.size());
+
+    // warmup runs fault in the pages, fill the caches and train the branch predictors; the first one also checks the output
+    bool correct = true;
+    double warmupMs = 0;
+    for (int i = 0; i < max(options.warmupRuns, 1); i++) {
+        warmupMs = runOnce(benchmarkCase, input, work);
+        if (i == 0 && benchmarkCase.sorts)
+            correct = is_sorted(work.begin(), work.end());
+    }
+
+    int trials = options.trials;
+    if (warmupMs > 0)
+        trials = min(trials, max(1, (int) (options.timeBudgetMs / warmupMs)));
+
+    vector<double> samples;
+    for (int i = 0; i < trials; i++)
+        samples.push_back(runOnce(benchmarkCase, input, work));
+    sort(samples.begin(), samples.end());
+
+    double total = 0;
+    for (double sample : samples)
+        total += sample;
+
+    BenchmarkResult result;
+    result.algorithm = benchmarkCase.name;
+    result.distribution = distributionName(distribution);
+    result.size = input.size();
+    result.trials = trials;
+    result.medianMs = samples.size() % 2 ? samples[samples.size() / 2]
+                                         : (samples[samples.size() / 2 - 1] + samples[samples.size() / 2]) / 2;
+    result.p95Ms = percentile(samples, 0.95);
+    result.meanMs = total / samples.size();
+    result.minMs = samples.front();
+    result.speedup = 0;
+    result.correct = correct;
+
+    // cases slower than the time budget are not instrumented, the extra runs would double their cost
+    if (result.medianMs <= options.timeBudgetMs) {
+        if (options.instrument) {
+            for (const BenchmarkMetric& metric : options.instrument(benchmarkCase, input))
+                result.metrics.push_back(metric);
+        }
+        if (benchmarkCase.collectMetrics) {
+            for (const BenchmarkMetric& metric : benchmarkCase.collectMetrics(input))
+                result.metrics.push_back(metric);
+        }
+    }
+    return result;
+}
+
+vector<BenchmarkResult> runBenchmarks(const vector<BenchmarkCase>& cases, const vector<int>& sizes,
+                                      const vector<InputDistribution>& distributions,
+                                      const BenchmarkOptions& options) {
+    vector<BenchmarkResult> results;
+    for (int size : sizes) {
+        for (InputDistribution distribution : distributions) {
+            cout << "Testing size: " << size << " (" << distributionName(distribution) << ")" << endl;
+            vector<int> input = generateInput(distribution, size, options.seed + size);
+
+            size_t first = results.size();
+            for (const BenchmarkCase& benchmarkCase : cases) {
+                if (!shouldRun(benchmarkCase, distribution, size)) {
+                    printf("Skipping %s\n", benchmarkCase.name.c_str());
+                    continue;
+                }
+                BenchmarkResult result = runBenchmark(benchmarkCase, input, distribution, options);
+
+                // the baseline ran earlier on the same input
+                for (size_t i = first; i < results.size() && !benchmarkCase.baseline.empty(); i++) {
+                    if (results[i].algorithm == benchmarkCase.baseline)
+                        result.speedup = results[i].medianMs / result.medianMs;
+                }
+                printResult(result);
+                results.push_back(result);
+            }
+            cout << endl;
+        }
+    }
+    return results;
+}
+
+void printResult(const BenchmarkResult& result) {
+    printf("Running time for %s is %f ms (median of %d, p95 %f ms)", result.algorithm.c_str(), result.medianMs,
+           result.trials, result.p95Ms);
+    if (result.speedup > 0)
+        printf(" (speedup %.2fx)", result.speedup);
+    if (!result.correct)
+        printf(" - OUTPUT NOT SORTED");
+    printf("\n");
+    for (const BenchmarkMetric& metric : result.metrics)
+        printf("    %s: %.0f\n", metric.name.c_str(), metric.value);
+}
+
+// one row per algorithm, distribution and size - the SortingGraph charts plot median_ms against size per algorithm
+void writeResultsCsv(const vector<BenchmarkResult>& results, const string& path) {
+    ofstream out(path);
+    if (!out) {
+        cerr << "Error: Could not open file '" << path << "'" << endl;
+        return;
+    }
+    // one column per metric name, left empty for the results that do not have it
+    vector<string> metricNames;
+    for (const BenchmarkResult& result : results) {
+        for (const BenchmarkMetric& metric : result.metrics) {
+            if (find(metricNames.begin(), metricNames.end(), metric.name) == metricNames.end())
+                metricNames.push_back(metric.name);
+        }
+    }
+
+    out << "algorithm,distribution,size,trials,median_ms,p95_ms,mean_ms,min_ms,speedup,correct";
+    for (const string& name : metricNames)
+        out << "," << name;
+    out << "\n";
+    for (const BenchmarkResult& result : results) {
+        out << "\"" << result.algorithm << "\"," << result.distribution << "," << result.size << ","
+            << result.trials << "," << result.medianMs << "," << result.p95Ms << "," << result.meanMs << ","
+            << result.minMs << "," << result.speedup << "," << (result.correct ? "true" : "false");
+        for (const string& name : metricNames) {
+            out << ",";
+            for (const BenchmarkMetric& metric : result.metrics) {
+                if (metric.name == name)
+                    out << (long long) metric.value;
+            }
+        }
+        out << "\n";
+    }
+}
+
+void writeResultsJson(const vector<BenchmarkResult>& results, const string& path) {
+    ofstream out(path);
+    if (!out) {
+        cerr << "Error: Could not open file '" << path << "'" << endl;
+        return;
+    }
+    out << "[\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchmarkResult& result = results[i];
+        out << "  {\"algorithm\": \"" << result.algorithm << "\", \"distribution\": \"" << result.distribution
+            << "\", \"size\": " << result.size << ", \"trials\": " << result.trials
+            << ", \"median_ms\": " << result.medianMs << ", \"p95_ms\": " << result.p95Ms
+            << ", \"mean_ms\": " << result.meanMs << ", \"min_ms\": " << result.minMs
+            << ", \"speedup\": " << result.speedup << ", \"correct\": " << (result.correct ? "true" : "false")
+            << ", \"metrics\": {";
+        for (size_t m = 0; m < result.metrics.size(); m++) {
+            out << (m > 0 ? ", " : "") << "\"" << result.metrics[m].name << "\": " << (long long) result.metrics[m].value;
+        }
+        out << "}}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "]\n";
+}
@@ -0,0 +1,92 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <climits>
+#include <functional>
+#include <string>
+#include <vector>
+
+enum InputDistribution {
+    RANDOM_INPUT, SORTED_INPUT, REVERSED_INPUT, FEW_UNIQUE_INPUT, ORGAN_PIPE_INPUT, ZIPF_INPUT, NEARLY_SORTED_INPUT
+};
+
+const std::vector<InputDistribution> ALL_DISTRIBUTIONS = {
+    RANDOM_INPUT, SORTED_INPUT, REVERSED_INPUT, FEW_UNIQUE_INPUT, ORGAN_PIPE_INPUT, ZIPF_INPUT, NEARLY_SORTED_INPUT
+};
+
+// distinct keys in a few unique input
+const int FEW_UNIQUE_VALUES = 16;
+// Zipf inputs draw their keys from this many ranks with exponent 1
+const int ZIPF_RANKS = 1 << 20;
+// a nearly sorted input has one element in this many swapped with a random other one and as many appended unsorted
+const int NEARLY_SORTED_SPACING = 100;
+// cases that go quadratic on an input are only run on it up to this size
+const int QUADRATIC_SIZE_LIMIT = 100000;
+
+// extra number reported next to the timings (e.g. comparisons, cache misses)
+struct BenchmarkMetric {
+    std::string name;
+    double value;
+};
+
+// collects metrics from one more run on a copy of the input, outside the timed trials
+typedef std::function<std::vector<BenchmarkMetric>(const std::vector<int>& input)> MetricCollector;
+
+// one algorithm under test, run() gets a copy of the input every trial
+struct BenchmarkCase {
+    std::string name;
+    std::function<void(int[], int)> run;
+    // name of an earlier case to report the speedup against, empty for none
+    std::string baseline = "";
+    // bigger inputs are skipped (quadratic sorts, sorts that keep the whole range on the stack)
+    int maxSize = INT_MAX;
+    // Lomuto partitions put every key equal to the pivot on one side, which is quadratic on few unique and Zipf inputs
+    bool quadraticOnDuplicates = false;
+    // false for the selection cases, their output is not checked for order
+    bool sorts = true;
+    // metrics only this case can produce, optional
+    MetricCollector collectMetrics = nullptr;
+    // what --mmap calls the case, the same on every CPU unlike name, empty if it cannot be picked there
+    std::string commandName = "";
+};
+
+struct BenchmarkOptions {
+    int warmupRuns = 1;
+    int trials = 5;
+    // slow cases run fewer trials so that one case takes about this long (but always at least one trial)
+    double timeBudgetMs = 5000;
+    unsigned seed = 42;
+    // metrics collected for every case, optional
+    std::function<std::vector<BenchmarkMetric>(const BenchmarkCase&, const std::vector<int>& input)> instrument = nullptr;
+};
+
+struct BenchmarkResult {
+    std::string algorithm;
+    std::string distribution;
+    int size;
+    int trials;
+    double medianMs;
+    double p95Ms;
+    double meanMs;
+    double minMs;
+    // baseline median / this median, 0 if the case has no baseline
+    double speedup;
+    bool correct;
+    std::vector<BenchmarkMetric> metrics;
+};
+
+const char* distributionName(InputDistribution distribution);
+std::vector<int> generateInput(InputDistribution distribution, int size, unsigned seed);
+
+bool shouldRun(const BenchmarkCase& benchmarkCase, InputDistribution distribution, int size);
+BenchmarkResult runBenchmark(const BenchmarkCase& benchmarkCase, const std::vector<int>& input,
+                             InputDistribution distribution, const BenchmarkOptions& options);
+std::vector<BenchmarkResult> runBenchmarks(const std::vector<BenchmarkCase>& cases, const std::vector<int>& sizes,
+                                           const std::vector<InputDistribution>& distributions,
+                                           const BenchmarkOptions& options);
+
+void printResult(const BenchmarkResult& result);
+void writeResultsCsv(const std::vector<BenchmarkResult>& results, const std::string& path);
+void writeResultsJson(const std::vector<BenchmarkResult>& results, const std::string& path);
+
+#endif //BENCHMARK_H
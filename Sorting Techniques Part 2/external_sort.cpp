@@ -0,0 +1,312 @@
+#include "external_sort.h"
+#include "sorting_techniques_part2.h"
+#include <algorithm>
+#include <cstdio>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+// reads a run file sequentially in big chunks, the next chunk is read in the background while the current one is merged
+class RunReader {
+private:
+    FILE* file;
+    vector<int> buffers[2];
+    int current;
+    size_t position;
+    size_t count;
+    // ints read and whether the read stopped on an error instead of the end of the file
+    future<pair<size_t, bool>> pending;
+    bool failed;
+
+    void readAhead() {
+        vector<int>* next = &buffers[1 - current];
+        FILE* source = file;
+        pending = async(launch::async, [next, source] {
+            size_t read = fread(next->data(), sizeof(int), next->size(), source);
+            return make_pair(read, ferror(source) != 0);
+        });
+    }
+
+public:
+    RunReader(FILE* file, size_t bufferInts) : file(file), current(0), position(0), count(0), failed(false) {
+        buffers[0].resize(bufferInts);
+        buffers[1].resize(bufferInts);
+        readAhead();
+        refill();
+    }
+
+    ~RunReader() {
+        if (pending.valid()) pending.wait();
+        fclose(file);
+    }
+
+    // switches to the chunk read in the background and starts reading the one after it
+    // a read error ends the run early like the end of the file would, error() tells them apart
+    void refill() {
+        auto [read, readError] = pending.get();
+        count = readError ? 0 : read;
+        failed = failed || readError;
+        current = 1 - current;
+        position = 0;
+        if (count > 0) readAhead();
+    }
+
+    bool error() {
+        return failed;
+    }
+
+    bool exhausted() {
+        return position == count;
+    }
+
+    int head() {
+        return buffers[current][position];
+    }
+
+    void advance() {
+        if (++position == count) refill();
+    }
+};
+
+// collects output in a buffer and writes full buffers in the background while the next one fills up
+class RunWriter {
+private:
+    FILE* file;
+    vector<int> buffers[2];
+    int current;
+    size_t count;
+    future<size_t> pending;
+    bool failed;
+
+    void waitForWrite() {
+        if (pending.valid() && pending.get() == 0)
+            failed = true;
+    }
+
+public:
+    RunWriter(FILE* file, size_t bufferInts) : file(file), current(0), count(0), failed(false) {
+        buffers[0].resize(bufferInts);
+        buffers[1].resize(bufferInts);
+    }
+
+    void push(int value) {
+        buffers[current][count++] = value;
+        if (count == buffers[current].size()) flush();
+    }
+
+    void flush() {
+        waitForWrite();
+        if (count == 0) return;
+        vector<int>* full = &buffers[current];
+        size_t size = count;
+        FILE* target = file;
+        pending = async(launch::async, [full, size, target] {
+            return fwrite(full->data(), sizeof(int), size, target) == size ? size : (size_t) 0;
+        });
+        current = 1 - current;
+        count = 0;
+    }
+
+    // flushes what is left and closes the file, false if any write failed
+    bool close() {
+        flush();
+        waitForWrite();
+        return fclose(file) == 0 && !failed;
+    }
+};
+
+// Tree of losers over k sources: every internal node keeps the loser of the match played there and tree[0] the overall winner,
+// so replacing the winner's key only replays the log2(k) matches on its path to the root (one comparison per level)
+class LoserTree {
+private:
+    vector<unique_ptr<RunReader>>& sources;
+    int k;
+    vector<int> tree;
+
+    // exhausted sources lose against everything, ties go to the lower index
+    bool beats(int a, int b) {
+        if (sources[a]->exhausted()) return false;
+        if (sources[b]->exhausted()) return true;
+        int keyA = sources[a]->head();
+        int keyB = sources[b]->head();
+        return keyA < keyB || (keyA == keyB && a < b);
+    }
+
+    // leaves are the nodes k..2k-1
+    int build(int node) {
+        if (node >= k) return node - k;
+        int left = build(2 * node);
+        int right = build(2 * node + 1);
+        if (beats(left, right)) {
+            tree[node] = right;
+            return left;
+        }
+        tree[node] = left;
+        return right;
+    }
+
+public:
+    explicit LoserTree(vector<unique_ptr<RunReader>>& sources) : sources(sources), k(sources.size()), tree(sources.size()) {
+        tree[0] = build(1);
+    }
+
+    bool empty() {
+        return sources[tree[0]]->exhausted();
+    }
+
+    int pop() {
+        int winner = tree[0];
+        int value = sources[winner]->head();
+        sources[winner]->advance();
+
+        for (int node = (winner + k) / 2; node >= 1; node /= 2) {
+            if (beats(tree[node], winner))
+                swap(tree[node], winner);
+        }
+        tree[0] = winner;
+        return value;
+    }
+};
+
+static string runPath(const string& outputPath, int pass, int index) {
+    return outputPath + ".pass" + to_string(pass) + ".run" + to_string(index);
+}
+
+static FILE* openFile(const string& path, const char* mode) {
+    FILE* file = fopen(path.c_str(), mode);
+    if (!file)
+        cerr << "Error: Could not open file '" << path << "'" << endl;
+    return file;
+}
+
+// phase 1: cuts the input into runs that fit the budget and sorts each one in memory
+static bool createRuns(const string& inputPath, const string& outputPath, long long memoryBudget,
+                       RunSortAlgorithm runSort, vector<string>& runs) {
+    FILE* input = openFile(inputPath, "rb");
+    if (!input) return false;
+
+    // the buffered merge sort needs a scratch buffer as big as the run
+    long long runInts = memoryBudget / sizeof(int) / (runSort == HYBRID_MERGE_SORT_RUNS ? 2 : 1);
+    runInts = max(1LL, min(runInts, (long long) INT32_MAX));
+    vector<int> run(runInts);
+
+    while (true) {
+        size_t count = fread(run.data(), sizeof(int), run.size(), input);
+        if (count == 0) break;
+
+        if (runSort == HYBRID_MERGE_SORT_RUNS)
+            bufferedHybridMergeSort(run.data(), 0, count - 1, 32);
+        else
+            quickSort(run.data(), 0, count - 1, BLOCK_PARTITION);
+
+        string path = runPath(outputPath, 0, runs.size());
+        FILE* output = openFile(path, "wb");
+        if (!output || fwrite(run.data(), sizeof(int), count, output) != count) {
+            if (output) fclose(output);
+            fclose(input);
+            return false;
+        }
+        fclose(output);
+        runs.push_back(path);
+    }
+
+    bool readError = ferror(input);
+    fclose(input);
+    if (readError)
+        cerr << "Error: Could not read file '" << inputPath << "'" << endl;
+    return !readError;
+}
+
+// phase 2: merges runs[first..last) into outputPath with two buffers per run and two for the output
+static bool mergeRuns(const vector<string>& runs, size_t first, size_t last, const string& outputPath,
+                      long long memoryBudget) {
+    long long k = last - first;
+    size_t bufferInts = max((long long) MIN_MERGE_BUFFER_INTS, memoryBudget / (long long) sizeof(int) / (2 * k + 2));
+
+    vector<unique_ptr<RunReader>> sources;
+    for (size_t i = first; i < last; i++) {
+        FILE* file = openFile(runs[i], "rb");
+        if (!file) return false;
+        sources.push_back(make_unique<RunReader>(file, bufferInts));
+    }
+    FILE* file = openFile(outputPath, "wb");
+    if (!file) return false;
+
+    RunWriter writer(file, bufferInts);
+    LoserTree tree(sources);
+    while (!tree.empty())
+        writer.push(tree.pop());
+
+    bool written = writer.close();
+    // a run that failed to read looks exhausted to the tree, so the output is complete only if none did
+    for (size_t i = first; i < last; i++) {
+        if (sources[i - first]->error()) {
+            cerr << "Error: Could not read file '" << runs[i] << "'" << endl;
+            return false;
+        }
+    }
+    if (!written) {
+        cerr << "Error: Could not write file '" << outputPath << "'" << endl;
+        return false;
+    }
+    return true;
+}
+
+bool externalSort(const string& inputPath, const string& outputPath, long long memoryBudget, RunSortAlgorithm runSort) {
+    // below this the merge buffers alone would use more memory than the budget
+    if (memoryBudget < MIN_MEMORY_BUDGET) {
+        cerr << "Error: The memory budget has to be at least " << MIN_MEMORY_BUDGET << " bytes" << endl;
+        return false;
+    }
+    vector<string> runs;
+    if (!createRuns(inputPath, outputPath, memoryBudget, runSort, runs)) {
+        for (const string& run : runs) remove(run.c_str());
+        return false;
+    }
+
+    // an empty input still produces an (empty) output file
+    if (runs.empty()) {
+        FILE* output = openFile(outputPath, "wb");
+        if (!output) return false;
+        fclose(output);
+        return true;
+    }
+
+    // as many runs per merge as the budget has room for minimum sized buffers, more runs take several passes
+    size_t fanIn = memoryBudget / sizeof(int) / MIN_MERGE_BUFFER_INTS / 2 - 1;
+    int pass = 0;
+    bool success = true;
+    while (runs.size() > 1 && success) {
+        pass++;
+        bool lastPass = runs.size() <= fanIn;
+        vector<string> merged;
+        for (size_t first = 0; first < runs.size() && success; first += fanIn) {
+            size_t last = min(first + fanIn, runs.size());
+            string path = lastPass ? outputPath : runPath(outputPath, pass, merged.size());
+            success = mergeRuns(runs, first, last, path, memoryBudget);
+            merged.push_back(path);
+        }
+        for (const string& run : runs) remove(run.c_str());
+        runs = merged;
+    }
+
+    if (!success) {
+        for (const string& run : runs) {
+            if (run != outputPath) remove(run.c_str());
+        }
+        return false;
+    }
+
+    // a single run is already the sorted output
+    if (runs[0] != outputPath) {
+        remove(outputPath.c_str());
+        if (rename(runs[0].c_str(), outputPath.c_str()) != 0) {
+            cerr << "Error: Could not write file '" << outputPath << "'" << endl;
+            success = false;
+        }
+    }
+    return success;
+}
@@ -0,0 +1,22 @@
+#ifndef EXTERNAL_SORT_H
+#define EXTERNAL_SORT_H
+
+#include <string>
+
+// how the runs that fit in memory get sorted
+enum RunSortAlgorithm { QUICK_SORT_RUNS, HYBRID_MERGE_SORT_RUNS };
+
+const long long DEFAULT_MEMORY_BUDGET = 256LL * 1024 * 1024;
+// smallest read/write buffer of the merge phase, more runs than the budget allows at this size are merged in several passes
+const int MIN_MERGE_BUFFER_INTS = 64 * 1024;
+// a 2-way merge, two buffers per run and two for the output, smaller budgets are rejected
+const long long MIN_MEMORY_BUDGET = 6LL * MIN_MERGE_BUFFER_INTS * sizeof(int);
+
+// Sorts a binary file of native int32 values that may be much bigger than memory into outputPath
+// 1. runs of memoryBudget bytes are read, sorted in memory and written to temporary files next to the output
+// 2. the runs are k-way merged through a loser tree with double buffered reads and writes
+// returns false (after printing the error) if a file could not be read or written or memoryBudget is below MIN_MEMORY_BUDGET
+bool externalSort(const std::string& inputPath, const std::string& outputPath,
+                  long long memoryBudget = DEFAULT_MEMORY_BUDGET, RunSortAlgorithm runSort = QUICK_SORT_RUNS);
+
+#endif //EXTERNAL_SORT_H
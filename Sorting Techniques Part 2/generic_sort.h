@@ -0,0 +1,197 @@
+#ifndef GENERIC_SORT_H
+#define GENERIC_SORT_H
+
+#include <functional>
+#include <iterator>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Header only versions of the sorts that work on any random access range instead of int arr[]
+// comp is called on the projected elements, so a struct can be sorted by one of its members without copying keys out:
+//     quickSort(people.begin(), people.end(), std::ranges::less{}, &Person::age);
+// everything is a template, so the comparator and projection get inlined for every element type
+
+// true if a goes before b
+template <class T, class U, class Compare, class Proj>
+bool projectedLess(const T& a, const U& b, Compare& comp, Proj& proj) {
+    return std::invoke(comp, std::invoke(proj, a), std::invoke(proj, b));
+}
+
+// swap found by argument dependent lookup, so element types with their own swap() (e.g. an instrumented one) get it
+template <class It>
+void swapElements(It a, It b) {
+    using std::swap;
+    swap(*a, *b);
+}
+
+template <class RandomIt, class Compare = std::ranges::less, class Proj = std::identity>
+void bubbleSort(RandomIt first, RandomIt last, Compare comp = {}, Proj proj = {}) {
+    auto size = last - first;
+    for (decltype(size) i = 0; i < size - 1; i++) {
+        bool isSorted = true;
+        for (decltype(size) j = 0; j < size - 1 - i; j++) {
+            if (projectedLess(first[j + 1], first[j], comp, proj)) {
+                swapElements(first + j, first + j + 1);
+                isSorted = false;
+            }
+        }
+        if (isSorted) break;
+    }
+}
+
+template <class RandomIt, class Compare = std::ranges::less, class Proj = std::identity>
+void selectionSort(RandomIt first, RandomIt last, Compare comp = {}, Proj proj = {}) {
+    for (RandomIt i = first; i < last; ++i) {
+        RandomIt min = i;
+        for (RandomIt j = i + 1; j < last; ++j) {
+            if (projectedLess(*j, *min, comp, proj))
+                min = j;
+        }
+        swapElements(i, min);
+    }
+}
+
+template <class RandomIt, class Compare = std::ranges::less, class Proj = std::identity>
+void insertionSort(RandomIt first, RandomIt last, Compare comp = {}, Proj proj = {}) {
+    if (first == last) return;
+    for (RandomIt i = first + 1; i < last; ++i) {
+        auto key = std::move(*i);
+        RandomIt j = i;
+        while (j > first && projectedLess(key, *(j - 1), comp, proj)) {
+            *j = std::move(*(j - 1));
+            --j;
+        }
+        *j = std::move(key);
+    }
+}
+
+// heapify down (max heap) - iterative version of maxHeapify
+template <class RandomIt, class Compare, class Proj>
+void siftDown(RandomIt first, std::iter_difference_t<RandomIt> heapSize, std::iter_difference_t<RandomIt> i,
+              Compare& comp, Proj& proj) {
+    while (true) {
+        auto l = 2 * i + 1;
+        auto r = 2 * i + 2;
+        auto largest = i;
+
+        if (l < heapSize && projectedLess(first[largest], first[l], comp, proj))
+            largest = l;
+        if (r < heapSize && projectedLess(first[largest], first[r], comp, proj))
+            largest = r;
+
+        if (largest == i) return;
+        swapElements(first + i, first + largest);
+        i = largest;
+    }
+}
+
+template <class RandomIt, class Compare = std::ranges::less, class Proj = std::identity>
+void heapSort(RandomIt first, RandomIt last, Compare comp = {}, Proj proj = {}) {
+    auto n = last - first;
+    for (auto i = n / 2 - 1; i >= 0; i--)
+        siftDown(first, n, i, comp, proj);
+
+    for (auto i = n - 1; i > 0; i--) {
+        swapElements(first, first + i);
+        siftDown(first, i, decltype(n)(0), comp, proj);
+    }
+}
+
+// moves the sorted left half [first, mid) into buffer and merges it with the sorted right half [mid, last) back into place
+// only the left half needs scratch space since the merge can never overtake the right half it is reading from
+template <class RandomIt, class Compare, class Proj>
+void mergeHalves(RandomIt first, RandomIt mid, RandomIt last, std::vector<std::iter_value_t<RandomIt>>& buffer,
+                 Compare& comp, Proj& proj) {
+    buffer.assign(std::make_move_iterator(first), std::make_move_iterator(mid));
+    auto left = buffer.begin();
+    RandomIt right = mid;
+    RandomIt out = first;
+    while (left != buffer.end() && right != last) {
+        // take from the right only when strictly smaller, which keeps the sort stable
+        if (projectedLess(*right, *left, comp, proj))
+            *out++ = std::move(*right++);
+        else
+            *out++ = std::move(*left++);
+    }
+    std::move(left, buffer.end(), out);
+}
+
+template <class RandomIt, class Compare, class Proj>
+void hybridMergeSortWithBuffer(RandomIt first, RandomIt last, std::iter_difference_t<RandomIt> threshold,
+                               std::vector<std::iter_value_t<RandomIt>>& buffer, Compare& comp, Proj& proj) {
+    if (last - first <= threshold || last - first < 2) {
+        insertionSort(first, last, comp, proj);
+        return;
+    }
+    RandomIt mid = first + (last - first) / 2;
+    hybridMergeSortWithBuffer(first, mid, threshold, buffer, comp, proj);
+    hybridMergeSortWithBuffer(mid, last, threshold, buffer, comp, proj);
+    mergeHalves(first, mid, last, buffer, comp, proj);
+}
+
+template <class RandomIt, class Compare = std::ranges::less, class Proj = std::identity>
+void hybridMergeSort(RandomIt first, RandomIt last, std::iter_difference_t<RandomIt> threshold,
+                     Compare comp = {}, Proj proj = {}) {
+    std::vector<std::iter_value_t<RandomIt>> buffer;
+    buffer.reserve((last - first) / 2 + 1);
+    hybridMergeSortWithBuffer(first, last, threshold, buffer, comp, proj);
+}
+
+template <class RandomIt, class Compare = std::ranges::less, class Proj = std::identity>
+void mergeSort(RandomIt first, RandomIt last, Compare comp = {}, Proj proj = {}) {
+    hybridMergeSort(first, last, 1, comp, proj);
+}
+
+// Lomuto partition around a random pivot like partition(), returns the final position of the pivot
+template <class RandomIt, class Compare, class Proj>
+RandomIt randomPartition(RandomIt first, RandomIt last, Compare& comp, Proj& proj) {
+    static thread_local std::minstd_rand engine(std::random_device{}());
+    RandomIt pivot = last - 1;
+    swapElements(first + engine() % (last - first), pivot);
+
+    RandomIt i = first;
+    for (RandomIt j = first; j < pivot; ++j) {
+        if (!projectedLess(*pivot, *j, comp, proj)) {
+            swapElements(i, j);
+            ++i;
+        }
+    }
+    swapElements(i, pivot);
+    return i;
+}
+
+template <class RandomIt, class Compare = std::ranges::less, class Proj = std::identity>
+void quickSort(RandomIt first, RandomIt last, Compare comp = {}, Proj proj = {}) {
+    while (last - first > 1) {
+        RandomIt pivot = randomPartition(first, last, comp, proj);
+        // recurse into the smaller side and loop on the bigger one so the stack stays O(logn)
+        if (pivot - first < last - pivot) {
+            quickSort(first, pivot, comp, proj);
+            first = pivot + 1;
+        } else {
+            quickSort(pivot + 1, last, comp, proj);
+            last = pivot;
+        }
+    }
+}
+
+// k is 1 based like quickSelect(), returns an iterator to the kth smallest element or last if k is out of range
+// the range is left partitioned around it
+template <class RandomIt, class Compare = std::ranges::less, class Proj = std::identity>
+RandomIt quickSelect(RandomIt first, RandomIt last, std::iter_difference_t<RandomIt> k, Compare comp = {}, Proj proj = {}) {
+    if (k < 1 || k > last - first) return last;
+    RandomIt target = first + (k - 1);
+    while (last - first > 1) {
+        RandomIt pivot = randomPartition(first, last, comp, proj);
+        if (pivot == target)
+            return target;
+        if (pivot > target)
+            last = pivot;
+        else
+            first = pivot + 1;
+    }
+    return target;
+}
+
+#endif //GENERIC_SORT_H
@@ -36,3 +36,61 @@ void heapSort(int arr[], int n) {
         maxHeapify(arr, i, 0);
     }
 }
+
+// Floyd's sift down for a D-ary heap - iterative, fills the hole at i with value
+// first walks the hole down to a leaf along the biggest children (D-1 comparisons per level, none against value),
+// then climbs back up to where value belongs, which is usually only a level or two since value came from the bottom
+template <int D>
+static void siftDownBottomUp(int arr[], int heap_size, int i, int value) {
+    int hole = i;
+    while (true) {
+        int first = D * hole + 1;
+        if (first >= heap_size) break;
+        int last = min(first + D, heap_size);
+
+        // the D children are next to each other in memory, so a level costs one or two cache lines instead of a miss per child
+        int largest = first;
+        for (int c = first + 1; c < last; c++) {
+            if (arr[c] > arr[largest])
+                largest = c;
+        }
+        arr[hole] = arr[largest];
+        hole = largest;
+    }
+
+    while (hole > i) {
+        int parent = (hole - 1) / D;
+        if (arr[parent] >= value) break;
+        arr[hole] = arr[parent];
+        hole = parent;
+    }
+    arr[hole] = value;
+}
+
+template <int D>
+static void bottomUpHeapSortD(int arr[], int n) {
+    // build max heap, bottom up from the last non-leaf node
+    for (int i = (n - 2) / D; i >= 0 && n > 1; i--)
+        siftDownBottomUp<D>(arr, n, i, arr[i]);
+
+    // move the max to the end and sift the displaced last element down from the root
+    for (int i = n - 1; i > 0; i--) {
+        int value = arr[i];
+        arr[i] = arr[0];
+        siftDownBottomUp<D>(arr, i, 0, value);
+    }
+}
+
+// a wider heap is shallower (log_d n levels), which trades a few more comparisons per level for fewer cache misses
+void bottomUpHeapSort(int arr[], int n, int arity) {
+    switch (arity) {
+        case 2:
+            bottomUpHeapSortD<2>(arr, n);
+            break;
+        case 8:
+            bottomUpHeapSortD<8>(arr, n);
+            break;
+        default:
+            bottomUpHeapSortD<4>(arr, n);
+    }
+}
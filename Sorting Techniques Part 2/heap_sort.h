@@ -5,4 +5,7 @@ void maxHeapify(int arr[], int heap_size, int i);
 void buildMaxHeap(int arr[], int n);
 void heapSort(int arr[], int n);
 
+// d-ary heap sort with Floyd's bottom-up sift down, arity is 2, 4 or 8
+void bottomUpHeapSort(int arr[], int n, int arity = 4);
+
 #endif //HEAP_SORT_H
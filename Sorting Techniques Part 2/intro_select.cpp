@@ -0,0 +1,125 @@
+#include "intro_select.h"
+#include "intro_sort.h"
+#include "sorting_techniques_part1.h"
+#include <algorithm>
+
+using namespace std;
+
+// BFPRT pivot: moves the median of every group of 5 to the front of the range and returns the index of their median
+// it is guaranteed to have at least 30% of the range on either side, which makes the selection linear in the worst case
+static int medianOfMediansIndex(int arr[], int low, int high) {
+    int n = high - low + 1;
+    if (n <= 5) {
+        insertionSort(arr + low, n);
+        return low + (n - 1) / 2;
+    }
+
+    int count = 0;
+    for (int i = low; i <= high; i += 5) {
+        int groupEnd = min(i + 4, high);
+        insertionSort(arr + i, groupEnd - i + 1);
+        swap(arr[low + count], arr[i + (groupEnd - i) / 2]);
+        count++;
+    }
+
+    int mid = low + (count - 1) / 2;
+    selectInPlace(arr, low, low + count - 1, mid);
+    return mid;
+}
+
+// median of three (or ninther) while the partitions keep halving the range, median of medians once they stop doing so
+static int selectPivotIndex(int arr[], int low, int high, int badSplits) {
+    if (badSplits >= SELECT_BAD_SPLIT_LIMIT)
+        return medianOfMediansIndex(arr, low, high);
+    return choosePivotIndex(arr, low, high);
+}
+
+// rearranges arr[low..high] so that arr[target] holds the element that would be there if the range was sorted,
+// with nothing bigger before it and nothing smaller after it
+void selectInPlace(int arr[], int low, int high, int target) {
+    int badSplits = 0;
+    while (high - low + 1 > SELECT_INSERTION_CUTOFF) {
+        int size = high - low + 1;
+        int pivot = hoarePartitionAround(arr, low, high, selectPivotIndex(arr, low, high, badSplits));
+        if (pivot == target) return;
+        if (target < pivot)
+            high = pivot - 1;
+        else
+            low = pivot + 1;
+
+        if (high - low + 1 > size / 2)
+            badSplits++;
+        else
+            badSplits = 0;
+    }
+    insertionSort(arr + low, high - low + 1);
+}
+
+// Introselect - same interface as quickSelect (k is 1 based) but O(n) in the worst case
+int introSelect(int arr[], int low, int high, int k) {
+    int target = low + k - 1;
+    //error case
+    if (k < 1 || target > high) return -1;
+    selectInPlace(arr, low, high, target);
+    return arr[target];
+}
+
+// partitions once for all targets: the ones left of the pivot continue in the left part, the rest in the right part
+// first..last are the sorted target indices that lie inside arr[low..high]
+static void multiSelectInPlace(int arr[], int low, int high, const int* first, const int* last) {
+    int badSplits = 0;
+    while (first != last) {
+        if (high - low + 1 <= SELECT_INSERTION_CUTOFF) {
+            insertionSort(arr + low, high - low + 1);
+            return;
+        }
+        if (last - first == 1) {
+            selectInPlace(arr, low, high, *first);
+            return;
+        }
+
+        int size = high - low + 1;
+        int pivot = hoarePartitionAround(arr, low, high, selectPivotIndex(arr, low, high, badSplits));
+        const int* split = lower_bound(first, last, pivot);
+        const int* after = (split != last && *split == pivot) ? split + 1 : split;
+
+        // recurse into the part with fewer targets and loop on the other one
+        if (split - first < last - after) {
+            multiSelectInPlace(arr, low, pivot - 1, first, split);
+            low = pivot + 1;
+            first = after;
+        } else {
+            multiSelectInPlace(arr, pivot + 1, high, after, last);
+            high = pivot - 1;
+            last = split;
+        }
+
+        if (high - low + 1 > size / 2)
+            badSplits++;
+        else
+            badSplits = 0;
+    }
+}
+
+// answers many order statistics (e.g. p50/p90/p99/p999) over the same array with one shared set of partitions
+// ks are 1 based like quickSelect, the result keeps their order and has -1 for a k outside the range
+vector<int> multiSelect(int arr[], int low, int high, const vector<int>& ks) {
+    vector<int> targets;
+    for (int k : ks) {
+        if (k >= 1 && low + k - 1 <= high)
+            targets.push_back(low + k - 1);
+    }
+    sort(targets.begin(), targets.end());
+    targets.erase(unique(targets.begin(), targets.end()), targets.end());
+
+    multiSelectInPlace(arr, low, high, targets.data(), targets.data() + targets.size());
+
+    vector<int> results;
+    for (int k : ks) {
+        if (k >= 1 && low + k - 1 <= high)
+            results.push_back(arr[low + k - 1]);
+        else
+            results.push_back(-1);
+    }
+    return results;
+}
@@ -0,0 +1,15 @@
+#ifndef INTRO_SELECT_H
+#define INTRO_SELECT_H
+
+#include <vector>
+
+// ranges up to this size are insertion sorted instead of partitioned further
+const int SELECT_INSERTION_CUTOFF = 16;
+// partitions in a row that may fail to halve the range before the pivot switches to median of medians
+const int SELECT_BAD_SPLIT_LIMIT = 2;
+
+void selectInPlace(int arr[], int low, int high, int target);
+int introSelect(int arr[], int low, int high, int k);
+std::vector<int> multiSelect(int arr[], int low, int high, const std::vector<int>& ks);
+
+#endif //INTRO_SELECT_H
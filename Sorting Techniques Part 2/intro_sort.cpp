@@ -0,0 +1,84 @@
+#include "intro_sort.h"
+#include "sorting_techniques_part1.h"
+#include "heap_sort.h"
+#include <iostream>
+
+using namespace std;
+
+// index of the median of arr[a], arr[b], arr[c]
+int medianOfThree(int arr[], int a, int b, int c) {
+    if (arr[a] < arr[b]) {
+        if (arr[b] < arr[c]) return b;
+        return arr[a] < arr[c] ? c : a;
+    }
+    if (arr[a] < arr[c]) return a;
+    return arr[b] < arr[c] ? c : b;
+}
+
+// median of three for small ranges, Tukey's ninther for big ones - both make sorted and reversed inputs split evenly
+int choosePivotIndex(int arr[], int low, int high) {
+    int mid = low + (high - low) / 2;
+    if (high - low + 1 <= NINTHER_CUTOFF)
+        return medianOfThree(arr, low, mid, high);
+
+    int step = (high - low + 1) / 8;
+    int first = medianOfThree(arr, low, low + step, low + 2 * step);
+    int middle = medianOfThree(arr, mid - step, mid, mid + step);
+    int last = medianOfThree(arr, high - 2 * step, high - step, high);
+    return medianOfThree(arr, first, middle, last);
+}
+
+// Hoare partition around the chosen pivot, returns its final index
+// both scans stop on keys equal to the pivot, so runs of duplicates get split down the middle instead of going quadratic
+int hoarePartition(int arr[], int low, int high) {
+    return hoarePartitionAround(arr, low, high, choosePivotIndex(arr, low, high));
+}
+
+// same partition around a pivot the caller already picked
+int hoarePartitionAround(int arr[], int low, int high, int pivotIndex) {
+    swap(arr[low], arr[pivotIndex]);
+    int pivot = arr[low];
+    int i = low + 1;
+    int j = high;
+    while (true) {
+        while (i <= j && arr[i] < pivot) i++;
+        while (i <= j && arr[j] > pivot) j--;
+        if (i >= j) break;
+        swap(arr[i++], arr[j--]);
+    }
+    swap(arr[low], arr[j]);
+    return j;
+}
+
+static void introSortLoop(int arr[], int low, int high, int depthLimit) {
+    while (high - low + 1 > INTRO_INSERTION_CUTOFF) {
+        // too many bad pivots in a row, heap sort keeps the worst case at O(nlogn)
+        if (depthLimit == 0) {
+            heapSort(arr + low, high - low + 1);
+            return;
+        }
+        depthLimit--;
+
+        int pivot = hoarePartition(arr, low, high);
+
+        // recurse into the smaller side and loop on the bigger one so the stack stays O(logn)
+        if (pivot - low < high - pivot) {
+            introSortLoop(arr, low, pivot - 1, depthLimit);
+            low = pivot + 1;
+        } else {
+            introSortLoop(arr, pivot + 1, high, depthLimit);
+            high = pivot - 1;
+        }
+    }
+    if (low < high)
+        insertionSort(arr + low, high - low + 1);
+}
+
+// Introsort - quick sort that switches to heap sort when recursion gets too deep and finishes small ranges with insertion sort
+void introSort(int arr[], int low, int high) {
+    if (low >= high) return;
+    int depthLimit = 0;
+    for (int n = high - low + 1; n > 1; n >>= 1)
+        depthLimit += 2;
+    introSortLoop(arr, low, high, depthLimit);
+}
@@ -0,0 +1,15 @@
+#ifndef INTRO_SORT_H
+#define INTRO_SORT_H
+
+// ranges up to this size are finished by insertion sort
+const int INTRO_INSERTION_CUTOFF = 16;
+// above this size the pivot is the ninther (median of three medians of three) instead of a plain median of three
+const int NINTHER_CUTOFF = 128;
+
+int medianOfThree(int arr[], int a, int b, int c);
+int choosePivotIndex(int arr[], int low, int high);
+int hoarePartition(int arr[], int low, int high);
+int hoarePartitionAround(int arr[], int low, int high, int pivotIndex);
+void introSort(int arr[], int low, int high);
+
+#endif //INTRO_SORT_H
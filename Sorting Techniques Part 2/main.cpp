@@ -1,215 +1,333 @@
 #include <iostream>
 #include <vector>
+#include <cstring>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
 #include "sorting_techniques_part1.h"
+#include "sorting_techniques_part2.h"
 #include "heap_sort.h"
+#include "parallel_sort.h"
+#include "radix_sort.h"
+#include "generic_sort.h"
+#include "intro_sort.h"
+#include "simd_sort.h"
+#include "intro_select.h"
+#include "benchmark.h"
+#include "perf_counters.h"
+#include "external_sort.h"
+#include "mapped_file.h"
+#include "power_sort.h"
+#include "threshold_tuning.h"
 
 using namespace std;
 
-int* generateRandArray(int size);
-void measureRuntime(int size);
+const string RESULTS_CSV = "sorting_results.csv";
+const string RESULTS_JSON = "sorting_results.json";
+
+// merge() keeps the whole merged range on the stack, past this size it overflows the default 8 MB stack
+const int STACK_MERGE_LIMIT = 1000000;
+
+vector<int> percentileRanks(int size);
+vector<BenchmarkCase> sortingCases(const ThresholdProfile& thresholds);
+AccessPattern accessPatternOf(const string& commandName);
+int sortMappedFile(const string& algorithm, const string& input, const string& output);
 void printArray(int arr[], int n);
 
-// Merge Sort
-void mergeSort(int arr[], int low, int high);
-void merge(int arr[], int low, int mid, int high);
+int main(int argc, char* argv[]) {
+    // Sorting_Techniques_Part_2 --external <input> <output> [memory budget in MB]
+    // sorts a binary file of ints that does not have to fit in memory instead of running the benchmarks
+    if (argc >= 4 && strcmp(argv[1], "--external") == 0) {
+        long long memoryBudget = DEFAULT_MEMORY_BUDGET;
+        if (argc >= 5) {
+            char* end;
+            long long megabytes = strtoll(argv[4], &end, 10);
+            if (*end != '\0' || megabytes <= 0 || megabytes > LLONG_MAX / (1024 * 1024)) {
+                cerr << "Error: The memory budget has to be a positive number of MB, not '" << argv[4] << "'" << endl;
+                return 1;
+            }
+            memoryBudget = megabytes * 1024 * 1024;
+        }
+        if (!externalSort(argv[2], argv[3], memoryBudget))
+            return 1;
+        cout << "Sorted " << argv[2] << " into " << argv[3] << endl;
+        return 0;
+    }
 
-// Quick Sort
-void quickSort(int arr[], int low, int high);
-int partition(int arr[], int low, int high);
+    // Sorting_Techniques_Part_2 --mmap <algorithm> <input> [output]
+    // sorts a binary file of ints in place through a memory mapping, or a mapped copy of it when output is given
+    if (argc >= 4 && strcmp(argv[1], "--mmap") == 0)
+        return sortMappedFile(argv[2], argv[3], argc >= 5 ? argv[4] : "");
+
+    // Sorting_Techniques_Part_2 --calibrate
+    // times the insertion sort cutoffs of the hybrid merge sorts again and saves them for later runs
+    if (argc >= 2 && strcmp(argv[1], "--calibrate") == 0) {
+        ThresholdProfile profile = calibrateThresholds();
+        if (!saveThresholdProfile(THRESHOLD_PROFILE_FILE, profile))
+            return 1;
+        cout << "Thresholds written to " << THRESHOLD_PROFILE_FILE << endl;
+        return 0;
+    }
 
-// Part 2 - Hybrid Merge Sort (Merge Sort with Insertion Sort) and Quick Select (Quick Sort with Selection)
-void hybridMergeSort(int arr[], int left, int right,int THRESHOLD);
-int quickSelect(int arr[], int low, int high, int k);
+    // Sorting_Techniques_Part_2 [--large]
+    // benchmarks every case up to 1M ints, --large adds the 10M and 100M inputs
+    bool large = argc >= 2 && strcmp(argv[1], "--large") == 0;
+    if (argc >= 2 && !large) {
+        cerr << "Error: Unknown option '" << argv[1] << "'" << endl;
+        return 1;
+    }
 
-int main() {
     // Test the Quick Select function
     int arr[] = {3, 41, 16, 25, 63, 52, 40};
     int size = sizeof(arr) / sizeof(arr[0]);
     int k = 3; // Find the 3rd smallest element
 
     int kthSmallest = quickSelect(arr, 0, size - 1, k);
-    printf("%dth smallest element is %d\n\n", k, kthSmallest);
+    printf("%dth smallest element is %d\n", k, kthSmallest);
+    printf("%dth smallest element with Intro Select is %d\n\n", k, introSelect(arr, 0, size - 1, k));
 
-    // seed random number generator to get different random numbers each time
+    // seed random number generator to get different pivots each time (the inputs come from the benchmark seed,
+    // the pivot engines of quickSort() are seeded from rand())
     srand(time(nullptr));
 
-    int testSizes[] = {1000, 10000, 25000, 50000, 75000, 100000};
-
-    for (int size : testSizes) {
-        cout << "Testing size: " << size << endl;
-        measureRuntime(size);
-        cout << endl;
+    // the first run on a CPU calibrates the cutoffs, every later one loads them
+    ThresholdProfile thresholds = thresholdProfile(THRESHOLD_PROFILE_FILE, true);
+    printf("Hybrid merge sort threshold %d, SIMD merge sort threshold %d\n\n", thresholds.hybridMergeThreshold,
+           thresholds.simdMergeThreshold);
+
+    vector<BenchmarkCase> cases = sortingCases(thresholds);
+    BenchmarkOptions options;
+    options.instrument = measureHardwareCounters;
+    vector<BenchmarkResult> results;
+
+    vector<int> testSizes = {1000, 10000, 25000, 50000, 75000, 100000};
+    results = runBenchmarks(cases, testSizes, ALL_DISTRIBUTIONS, options);
+
+    // the quadratic sorts skip themselves here, they would take hours at these sizes
+    vector<int> largeTestSizes = {1000000};
+    vector<BenchmarkResult> largeResults = runBenchmarks(cases, largeTestSizes, ALL_DISTRIBUTIONS, options);
+    results.insert(results.end(), largeResults.begin(), largeResults.end());
+    int largestSize = largeTestSizes.back();
+
+    // the 10M and 100M tiers take well over an hour, so they only run when asked for
+    if (large) {
+        vector<int> hugeTestSizes = {10000000};
+        vector<BenchmarkResult> hugeResults = runBenchmarks(cases, hugeTestSizes, ALL_DISTRIBUTIONS, options);
+        results.insert(results.end(), hugeResults.begin(), hugeResults.end());
+
+        // random input only, every other distribution would multiply an already long run
+        vector<int> hugestTestSizes = {100000000};
+        vector<BenchmarkResult> hugestResults = runBenchmarks(cases, hugestTestSizes, {RANDOM_INPUT}, options);
+        results.insert(results.end(), hugestResults.begin(), hugestResults.end());
+        largestSize = hugestTestSizes.back();
     }
 
-    return 0;
-}
+    // the buffered sorts allocate their scratch buffer once on the heap, merge() needs the same amount on the stack at the top level
+    printf("Peak scratch memory for the buffered merge sorts is %.1f MB on the heap at size %d\n\n",
+           largestSize * sizeof(int) / 1048576.0, largestSize);
 
-int quickSelect(int arr[], int low, int high, int k){
-
-    if(low<=high){
-        int pivot=partition(arr,low,high);
-        //checks if pivot found equals k
-        if(pivot==k-1)
-            return arr[pivot];
-        //checks if k less than pivot takes left subarray
-        if(pivot>k-1)
-            return quickSelect(arr,low,pivot-1,k);
-        //takes the right subarray (bigger than pivot)
-        return quickSelect(arr,pivot+1,high,k);
-    }
-    //error case
-    return -1;
+    writeResultsCsv(results, RESULTS_CSV);
+    writeResultsJson(results, RESULTS_JSON);
+    cout << "Results written to " << RESULTS_CSV << " and " << RESULTS_JSON << endl;
 
+    return 0;
 }
 
-int* generateRandArray(int size) {
-    int* arr = new int[size];
-
-    for (int i = 0; i < size; i++)
-        arr[i] = rand();
-
-    return arr;
+// 1 based ranks of p50, p90, p99 and p999
+vector<int> percentileRanks(int size) {
+    vector<int> ks;
+    int permille[] = {500, 900, 990, 999};
+    for (int p : permille)
+        ks.push_back(max(1, (int) ((long long) size * p / 1000)));
+    return ks;
 }
 
-void measureRuntime(int size) {
-    clock_t start, end;
-    double cpu_time_used;
-
-    int* arr = generateRandArray(size);
-    int* arrCopy = new int[size];
-
-    // Bubble Sort
-    memcpy(arrCopy, arr, size * sizeof(int));
-    start = clock();
-    bubbleSort(arrCopy, size);
-    end = clock();
-    cpu_time_used = (((double)(end - start)) / CLOCKS_PER_SEC) * 1000;
-    printf("Running time for Bubble Sort is %f ms\n", cpu_time_used);
-
-    // Selection Sort
-    memcpy(arrCopy, arr, size * sizeof(int));
-    start = clock();
-    selectionSort(arrCopy, size);
-    end = clock();
-    cpu_time_used = (((double) (end - start)) / CLOCKS_PER_SEC) * 1000;
-    printf("Running time for Selection Sort is %f ms\n", cpu_time_used);
-
-    // Insertion Sort
-    memcpy(arrCopy, arr, size * sizeof(int));
-    start = clock();
-    insertionSort(arrCopy, size);
-    end = clock();
-    cpu_time_used = (((double) (end - start)) / CLOCKS_PER_SEC) * 1000;
-    printf("Running time for Insertion Sort is %f ms\n", cpu_time_used);
-
-    // Heap Sort
-    memcpy(arrCopy, arr, size * sizeof(int));
-    start = clock();
-    heapSort(arrCopy, size);
-    end = clock();
-    cpu_time_used = (((double) (end - start)) / CLOCKS_PER_SEC) * 1000;
-    printf("Running time for Heap Sort is %f ms\n", cpu_time_used);
-
-    // Merge Sort
-    memcpy(arrCopy, arr, size * sizeof(int));
-    start = clock();
-    mergeSort(arrCopy, 0, size - 1);
-    end = clock();
-    cpu_time_used = (((double) (end - start)) / CLOCKS_PER_SEC) * 1000;
-    printf("Running time for Merge Sort is %f ms\n", cpu_time_used);
-
-    // Quick Sort
-    memcpy(arrCopy, arr, size * sizeof(int));
-    start = clock();
-    quickSort(arrCopy, 0, size - 1);
-    end = clock();
-    cpu_time_used = (((double) (end - start)) / CLOCKS_PER_SEC) * 1000;
-    printf("Running time for Quick Sort is %f ms\n", cpu_time_used);
-
-    // Hybrid Merge Sort
-    memcpy(arrCopy, arr, size * sizeof(int));
-    start = clock();
-    hybridMergeSort(arrCopy, 0, size - 1,32);
-    end = clock();
-    cpu_time_used = (((double) (end - start)) / CLOCKS_PER_SEC) * 1000;
-    printf("Running time for Hybrid Merge Sort is %f ms\n", cpu_time_used);
-
-    delete[] arr;
-    delete[] arrCopy;
+// every algorithm of the project behind the same (arr, size) signature, baselines have to come before the cases using them
+// the ones with a generic_sort.h counterpart also report its comparisons and element moves
+vector<BenchmarkCase> sortingCases(const ThresholdProfile& thresholds) {
+    vector<BenchmarkCase> cases;
+    int threshold = thresholds.hybridMergeThreshold;
+    int simdThreshold = thresholds.simdMergeThreshold;
+
+    cases.push_back({"Bubble Sort", [](int arr[], int size) { bubbleSort(arr, size); }, "", QUADRATIC_SIZE_LIMIT});
+    cases.back().commandName = "bubble-sort";
+    cases.back().collectMetrics = operationCounter([](auto first, auto last, auto comp, auto proj) { bubbleSort(first, last, comp, proj); });
+    cases.push_back({"Selection Sort", [](int arr[], int size) { selectionSort(arr, size); }, "", QUADRATIC_SIZE_LIMIT});
+    cases.back().commandName = "selection-sort";
+    cases.back().collectMetrics = operationCounter([](auto first, auto last, auto comp, auto proj) { selectionSort(first, last, comp, proj); });
+    cases.push_back({"Insertion Sort", [](int arr[], int size) { insertionSort(arr, size); }, "", QUADRATIC_SIZE_LIMIT});
+    cases.back().commandName = "insertion-sort";
+    cases.back().collectMetrics = operationCounter([](auto first, auto last, auto comp, auto proj) { insertionSort(first, last, comp, proj); });
+
+    cases.push_back({"Heap Sort", [](int arr[], int size) { heapSort(arr, size); }});
+    cases.back().commandName = "heap-sort";
+    cases.back().collectMetrics = operationCounter([](auto first, auto last, auto comp, auto proj) { heapSort(first, last, comp, proj); });
+    cases.push_back({"Bottom-up 2-ary Heap Sort", [](int arr[], int size) { bottomUpHeapSort(arr, size, 2); }, "Heap Sort"});
+    cases.back().commandName = "bottom-up-2-ary-heap-sort";
+    cases.push_back({"Bottom-up 4-ary Heap Sort", [](int arr[], int size) { bottomUpHeapSort(arr, size, 4); }, "Heap Sort"});
+    cases.back().commandName = "bottom-up-4-ary-heap-sort";
+    cases.push_back({"Bottom-up 8-ary Heap Sort", [](int arr[], int size) { bottomUpHeapSort(arr, size, 8); }, "Heap Sort"});
+    cases.back().commandName = "bottom-up-8-ary-heap-sort";
+
+    cases.push_back({"Merge Sort", [](int arr[], int size) { mergeSort(arr, 0, size - 1); }, "", STACK_MERGE_LIMIT});
+    cases.back().commandName = "merge-sort";
+    cases.back().collectMetrics = operationCounter([](auto first, auto last, auto comp, auto proj) { mergeSort(first, last, comp, proj); });
+    cases.push_back({"Buffered Merge Sort", [](int arr[], int size) { bufferedMergeSort(arr, 0, size - 1); }, "Merge Sort"});
+    cases.back().commandName = "buffered-merge-sort";
+
+    cases.push_back({"Quick Sort", [](int arr[], int size) { quickSort(arr, 0, size - 1); }, "", INT_MAX, true});
+    cases.back().commandName = "quick-sort";
+    cases.back().collectMetrics = operationCounter([](auto first, auto last, auto comp, auto proj) { quickSort(first, last, comp, proj); });
+    cases.push_back({"Quick Sort (block partition)", [](int arr[], int size) { quickSort(arr, 0, size - 1, BLOCK_PARTITION); },
+                     "Quick Sort"});
+    cases.back().commandName = "quick-sort-block-partition";
+    // templated version, the comparator gets inlined
+    cases.push_back({"Generic Quick Sort", [](int arr[], int size) { quickSort(arr, arr + size); }, "Quick Sort", INT_MAX, true});
+    cases.back().commandName = "generic-quick-sort";
+    cases.push_back({"Intro Sort", [](int arr[], int size) { introSort(arr, 0, size - 1); }, "Quick Sort"});
+    cases.back().commandName = "intro-sort";
+    cases.push_back({"Radix Sort", [](int arr[], int size) { radixSort(arr, size); }, "Quick Sort"});
+    cases.back().commandName = "radix-sort";
+
+    cases.push_back({"Hybrid Merge Sort", [threshold](int arr[], int size) { hybridMergeSort(arr, 0, size - 1, threshold); }, "",
+                     STACK_MERGE_LIMIT});
+    cases.back().commandName = "hybrid-merge-sort";
+    cases.back().collectMetrics = operationCounter([threshold](auto first, auto last, auto comp, auto proj) {
+        hybridMergeSort(first, last, threshold, comp, proj);
+    });
+    cases.push_back({"Buffered Hybrid Merge Sort", [threshold](int arr[], int size) { bufferedHybridMergeSort(arr, 0, size - 1, threshold); },
+                     "Hybrid Merge Sort"});
+    cases.back().commandName = "buffered-hybrid-merge-sort";
+    // falls back to the scalar kernels without AVX2
+    cases.push_back({simdSortAvailable() ? "SIMD Hybrid Merge Sort (AVX2)" : "SIMD Hybrid Merge Sort (scalar)",
+                     [simdThreshold](int arr[], int size) { simdHybridMergeSort(arr, 0, size - 1, simdThreshold); }, "Buffered Hybrid Merge Sort"});
+    cases.back().commandName = "simd-hybrid-merge-sort";
+    // merges the runs already in the input instead of splitting at the midpoint
+    cases.push_back({"Power Sort", [](int arr[], int size) { powerSort(arr, size); }, "Buffered Hybrid Merge Sort"});
+    cases.back().commandName = "power-sort";
+
+    cases.push_back({"Parallel Quick Sort", [](int arr[], int size) { parallelQuickSort(arr, 0, size - 1); }, "Quick Sort",
+                     INT_MAX, true});
+    cases.back().commandName = "parallel-quick-sort";
+    cases.push_back({"Parallel Hybrid Merge Sort", [threshold](int arr[], int size) { parallelHybridMergeSort(arr, 0, size - 1, threshold); },
+                     "Buffered Hybrid Merge Sort"});
+    cases.back().commandName = "parallel-hybrid-merge-sort";
+
+    // p50/p90/p99/p999 - one quickSelect per k against one multiSelect for all of them
+    cases.push_back({"Quick Select (4 percentiles)", [](int arr[], int size) {
+        for (int k : percentileRanks(size))
+            quickSelect(arr, 0, size - 1, k);
+    }, "", INT_MAX, true, false});
+    cases.back().collectMetrics = operationCounter([](auto first, auto last, auto comp, auto proj) {
+        for (int k : percentileRanks(last - first))
+            quickSelect(first, last, k, comp, proj);
+    });
+    cases.push_back({"Intro Select (4 percentiles)", [](int arr[], int size) {
+        for (int k : percentileRanks(size))
+            introSelect(arr, 0, size - 1, k);
+    }, "Quick Select (4 percentiles)", INT_MAX, false, false});
+    cases.push_back({"Multi Select (4 percentiles)", [](int arr[], int size) {
+        multiSelect(arr, 0, size - 1, percentileRanks(size));
+    }, "Quick Select (4 percentiles)", INT_MAX, false, false});
+
+    return cases;
 }
 
-void printArray(int arr[], int n) {
-    for (int i = 0; i < n; i++)
-        cout << arr[i] << " ";
-    cout << endl;
-}
-
-void mergeSort(int arr[], int low, int high) {
-    if (low >= high) return;
-    int mid = low + (high - low) / 2;
-    mergeSort(arr, low, mid);
-    mergeSort(arr, mid + 1, high);
-    merge(arr, low, mid, high);
+// Page cache hint for the mapping a case sorts in place
+// every sort here comes back to the same pages more than once, so none of them gets SEQUENTIAL (which lets the kernel
+// drop a page right after it was read), that one is only for the single pass copy of the input
+AccessPattern accessPatternOf(const string& commandName) {
+    static const vector<pair<string, AccessPattern>> patterns = {
+            // one pass per element over the unsorted part
+            {"bubble-sort", NORMAL_ACCESS},
+            {"selection-sort", NORMAL_ACCESS},
+            {"insertion-sort", NORMAL_ACCESS},
+            // sift downs jump between a node and its children all over the array
+            {"heap-sort", RANDOM_ACCESS},
+            {"bottom-up-2-ary-heap-sort", RANDOM_ACCESS},
+            {"bottom-up-4-ary-heap-sort", RANDOM_ACCESS},
+            {"bottom-up-8-ary-heap-sort", RANDOM_ACCESS},
+            // log n merge passes over the whole array
+            {"merge-sort", NORMAL_ACCESS},
+            {"buffered-merge-sort", NORMAL_ACCESS},
+            {"hybrid-merge-sort", NORMAL_ACCESS},
+            {"buffered-hybrid-merge-sort", NORMAL_ACCESS},
+            {"power-sort", NORMAL_ACCESS},
+            {"simd-hybrid-merge-sort", NORMAL_ACCESS},
+            {"parallel-hybrid-merge-sort", NORMAL_ACCESS},
+            // partitions rescan smaller and smaller ranges
+            {"quick-sort", NORMAL_ACCESS},
+            {"quick-sort-block-partition", NORMAL_ACCESS},
+            {"generic-quick-sort", NORMAL_ACCESS},
+            {"intro-sort", NORMAL_ACCESS},
+            {"parallel-quick-sort", NORMAL_ACCESS},
+            // a histogram pass plus one scatter pass per digit, the scatter writes to 256 places at once
+            {"radix-sort", NORMAL_ACCESS},
+    };
+    for (const auto& [name, pattern] : patterns) {
+        if (name == commandName) return pattern;
+    }
+    return NORMAL_ACCESS;
 }
 
-void merge(int arr[], int low, int mid, int high) {
-    int size = high - low + 1;
-    int temp[size];
-    int index = 0;
-    int left = low;
-    int right = mid + 1;
-    while (left <= mid && right <= high) {
-        if (arr[left] <= arr[right]) {
-            temp[index++] = arr[left++];
-        }
-        else {
-            temp[index++] = arr[right++];
-        }
+int sortMappedFile(const string& algorithm, const string& input, const string& output) {
+    // a mapped sort runs once, so it does not calibrate and uses the defaults if no profile was saved yet
+    vector<BenchmarkCase> cases = sortingCases(thresholdProfile(THRESHOLD_PROFILE_FILE, false));
+    const BenchmarkCase* sortCase = nullptr;
+    for (const BenchmarkCase& c : cases) {
+        if (!c.commandName.empty() && c.commandName == algorithm)
+            sortCase = &c;
     }
-    while (left <= mid) {
-        temp[index++] = arr[left++];
+    if (!sortCase) {
+        cerr << "Error: Unknown algorithm '" << algorithm << "', one of:" << endl;
+        for (const BenchmarkCase& c : cases) {
+            if (!c.commandName.empty()) cerr << "  " << c.commandName << endl;
+        }
+        return 1;
     }
-    while (right <= high) {
-        temp[index++] = arr[right++];
+
+    // writing a copy over its own source would truncate it before it is read, so that is an in place sort
+    bool inPlace = output.empty() || sameFile(input, output);
+    MappedFile source;
+    if (!source.open(input, inPlace))
+        return 1;
+    if (source.intCount() > (size_t) sortCase->maxSize) {
+        cerr << "Error: " << sortCase->name << " is limited to " << sortCase->maxSize << " ints" << endl;
+        return 1;
     }
-    for (int i = 0; i < size; i++) {
-        arr[low + i] = temp[i];
+    if (source.intCount() > INT_MAX) {
+        cerr << "Error: '" << input << "' has more than " << INT_MAX << " ints, use --external" << endl;
+        return 1;
     }
-}
 
-void quickSort(int arr[], int low,int high) {
-    if (low < high) {
-        int pivot = partition(arr,low,high);
-        quickSort(arr,low,pivot-1);
-        quickSort(arr,pivot+1,high);
+    // the output mapping starts as a copy of the input, page cache to page cache, and is sorted in place from there
+    MappedFile destination;
+    MappedFile* target = &source;
+    if (!inPlace) {
+        if (!destination.create(output, source.intCount() * sizeof(int)))
+            return 1;
+        source.advise(SEQUENTIAL_ACCESS);
+        if (source.intCount() > 0)
+            memcpy(destination.ints(), source.ints(), source.intCount() * sizeof(int));
+        target = &destination;
     }
-}
+    target->advise(accessPatternOf(sortCase->commandName));
 
-int partition(int arr[], int low, int high) {
-    int randomIndex = low + rand() % (high - low + 1);
-    swap(arr[randomIndex], arr[high]);
-    int pivot = arr[high];
-    int i = low - 1;
-    for (int j = low; j <= high - 1; j++) {
-        if (arr[j] <= pivot) {
-            i += 1;
-            swap(arr[i], arr[j]);
-        }
+    int size = (int) target->intCount();
+    auto start = chrono::steady_clock::now();
+    sortCase->run(target->ints(), size);
+    double sortMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    if (!target->sync()) {
+        cerr << "Error: Could not write back '" << (inPlace ? input : output) << "'" << endl;
+        return 1;
     }
-    i += 1;
-    swap(arr[i], arr[high]);
-    return i;
+    printf("Running time for %s on %d mapped ints is %f ms\n", sortCase->name.c_str(), size, sortMs);
+    return 0;
 }
 
-void hybridMergeSort(int arr[], int left, int right,int THRESHOLD) {
-    if (right - left + 1 <= THRESHOLD) {
-        insertionSort(arr + left, right - left + 1);
-        return;
-    }
-    if (left < right) {
-        int mid = left + (right - left) / 2;
-        hybridMergeSort(arr, left, mid,THRESHOLD);
-        hybridMergeSort(arr, mid + 1, right,THRESHOLD);
-        merge(arr, left, mid, right);
-    }
+void printArray(int arr[], int n) {
+    for (int i = 0; i < n; i++)
+        cout << arr[i] << " ";
+    cout << endl;
 }
@@ -0,0 +1,131 @@
+#include "mapped_file.h"
+#include <iostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MAPPED_FILE_POSIX
+#endif
+
+using namespace std;
+
+MappedFile::MappedFile() : fd(-1), address(nullptr), length(0) {}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+int* MappedFile::ints() {
+    return (int*) address;
+}
+
+size_t MappedFile::intCount() {
+    return length / sizeof(int);
+}
+
+#ifdef MAPPED_FILE_POSIX
+// maps fd as it is now, an empty file has nothing to map
+static void* mapFile(int fd, size_t length, bool writable) {
+    if (length == 0) return nullptr;
+    void* address = mmap(nullptr, length, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+    return address == MAP_FAILED ? nullptr : address;
+}
+
+bool MappedFile::open(const string& path, bool writable) {
+    close();
+    fd = ::open(path.c_str(), writable ? O_RDWR : O_RDONLY);
+    struct stat info;
+    if (fd < 0 || fstat(fd, &info) != 0) {
+        cerr << "Error: Could not open file '" << path << "'" << endl;
+        close();
+        return false;
+    }
+    if (info.st_size % sizeof(int) != 0) {
+        cerr << "Error: File '" << path << "' is not a whole number of ints" << endl;
+        close();
+        return false;
+    }
+
+    length = info.st_size;
+    address = mapFile(fd, length, writable);
+    if (length > 0 && !address) {
+        cerr << "Error: Could not map file '" << path << "'" << endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool MappedFile::create(const string& path, size_t size) {
+    close();
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0 || ftruncate(fd, size) != 0) {
+        cerr << "Error: Could not create file '" << path << "'" << endl;
+        close();
+        return false;
+    }
+
+    length = size;
+    address = mapFile(fd, length, true);
+    if (length > 0 && !address) {
+        cerr << "Error: Could not map file '" << path << "'" << endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+void MappedFile::close() {
+    if (address) munmap(address, length);
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+    address = nullptr;
+    length = 0;
+}
+
+void MappedFile::advise(AccessPattern pattern) {
+    if (!address) return;
+    // every page is touched at least once, so start reading all of them now
+    madvise(address, length, MADV_WILLNEED);
+    // sequential doubles the readahead window and lets pages go once they are read, random turns readahead off so a
+    // jump does not drag in pages it will not use, normal keeps the default for sorts that come back to every page
+    int advice = MADV_NORMAL;
+    if (pattern == SEQUENTIAL_ACCESS) advice = MADV_SEQUENTIAL;
+    if (pattern == RANDOM_ACCESS) advice = MADV_RANDOM;
+    madvise(address, length, advice);
+}
+
+bool MappedFile::sync() {
+    return !address || msync(address, length, MS_SYNC) == 0;
+}
+
+bool sameFile(const string& a, const string& b) {
+    struct stat infoA, infoB;
+    if (stat(a.c_str(), &infoA) != 0 || stat(b.c_str(), &infoB) != 0) return false;
+    return infoA.st_dev == infoB.st_dev && infoA.st_ino == infoB.st_ino;
+}
+#else
+bool MappedFile::open(const string& path, bool writable) {
+    cerr << "Error: Memory mapped files are not supported on this platform" << endl;
+    return false;
+}
+
+bool MappedFile::create(const string& path, size_t size) {
+    cerr << "Error: Memory mapped files are not supported on this platform" << endl;
+    return false;
+}
+
+void MappedFile::close() {}
+
+void MappedFile::advise(AccessPattern pattern) {}
+
+bool MappedFile::sync() {
+    return false;
+}
+
+bool sameFile(const string& a, const string& b) {
+    return a == b;
+}
+#endif
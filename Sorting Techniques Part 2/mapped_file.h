@@ -0,0 +1,45 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+// page cache hint matching how an algorithm walks the array
+// NORMAL: several passes over the same pages (keep them cached), SEQUENTIAL: one front to back pass (pages can be
+// dropped right after), RANDOM: jumps all over the array (no readahead)
+enum AccessPattern { NORMAL_ACCESS, SEQUENTIAL_ACCESS, RANDOM_ACCESS };
+
+// A binary file of ints mapped read/write into memory (MAP_SHARED), so sorting the ints sorts the file
+// without a read() into a separate buffer; sync() flushes the dirty pages back to the file
+class MappedFile {
+private:
+    int fd;
+    void* address;
+    size_t length;
+
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // maps an existing file, false (after printing the error) if it cannot be opened or is not a whole number of ints
+    // a file that is only read (the source of a copy) is opened read only, so it may be a read only file
+    bool open(const std::string& path, bool writable = true);
+    // creates (or truncates) a file of the given size and maps it
+    bool create(const std::string& path, size_t size);
+    void close();
+
+    int* ints();
+    size_t intCount();
+
+    // asks the kernel to read the whole file ahead (willneed) plus a readahead policy for the access pattern
+    void advise(AccessPattern pattern);
+    bool sync();
+};
+
+// true if both paths name the same file (same device and inode), false if either does not exist
+bool sameFile(const std::string& a, const std::string& b);
+
+#endif //MAPPED_FILE_H
@@ -0,0 +1,47 @@
+#include "parallel_sort.h"
+#include "sorting_techniques_part2.h"
+#include "work_stealing_pool.h"
+#include <vector>
+
+using namespace std;
+
+// partitions on this thread, hands the left side to the pool and keeps splitting the right side itself
+static void parallelQuickSortTask(int arr[], int low, int high, TaskGroup& group) {
+    while (high - low + 1 > PARALLEL_CUTOFF) {
+        int pivot = partition(arr, low, high);
+        group.run([arr, low, pivot, &group] { parallelQuickSortTask(arr, low, pivot - 1, group); });
+        low = pivot + 1;
+    }
+    quickSort(arr, low, high);
+}
+
+void parallelQuickSort(int arr[], int low, int high) {
+    TaskGroup group(WorkStealingPool::shared());
+    parallelQuickSortTask(arr, low, high, group);
+    group.wait();
+}
+
+// same ping-pong scheme as hybridMergeSortInto, the left half runs on the pool while this thread sorts the right half
+static void parallelHybridMergeSortInto(int src[], int dst[], int left, int right, int THRESHOLD) {
+    if (right - left + 1 <= PARALLEL_CUTOFF) {
+        hybridMergeSortInto(src, dst, left, right, THRESHOLD);
+        return;
+    }
+    int mid = left + (right - left) / 2;
+
+    // both halves have to be sorted before they can be merged, so every level waits on its own group
+    TaskGroup group(WorkStealingPool::shared());
+    group.run([src, dst, left, mid, THRESHOLD] { parallelHybridMergeSortInto(dst, src, left, mid, THRESHOLD); });
+    parallelHybridMergeSortInto(dst, src, mid + 1, right, THRESHOLD);
+    group.wait();
+
+    mergeInto(src, dst, left, mid, right);
+}
+
+void parallelHybridMergeSort(int arr[], int left, int right, int THRESHOLD) {
+    if (left >= right) return;
+    int size = right - left + 1;
+    // one shared scratch buffer, merge() would put the whole range on the stack of a worker thread
+    vector<int> buffer(arr + left, arr + right + 1);
+    parallelHybridMergeSortInto(buffer.data(), arr + left, 0, size - 1, THRESHOLD);
+}
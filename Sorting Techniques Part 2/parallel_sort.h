@@ -0,0 +1,10 @@
+#ifndef PARALLEL_SORT_H
+#define PARALLEL_SORT_H
+
+// subranges smaller than this are sorted serially, splitting them further costs more than it saves
+const int PARALLEL_CUTOFF = 1 << 14;
+
+void parallelQuickSort(int arr[], int low, int high);
+void parallelHybridMergeSort(int arr[], int left, int right, int THRESHOLD);
+
+#endif //PARALLEL_SORT_H
@@ -0,0 +1,128 @@
+#include "perf_counters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+using namespace std;
+
+const char* hardwareCounterName(HardwareCounter counter) {
+    switch (counter) {
+        case CYCLES_COUNTER: return "cycles";
+        case INSTRUCTIONS_COUNTER: return "instructions";
+        case L1D_MISSES_COUNTER: return "l1d_misses";
+        case LLC_MISSES_COUNTER: return "llc_misses";
+        case BRANCH_MISSES_COUNTER: return "branch_misses";
+    }
+    return "unknown";
+}
+
+#ifdef __linux__
+// in the group of leader (-1 to start a group), or on its own if it does not fit in that group
+static int openCounter(unsigned type, unsigned long long config, int leader) {
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    // this thread on any CPU
+    int fd = syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0);
+    if (fd < 0 && leader >= 0)
+        fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    return fd;
+}
+
+static unsigned long long cacheConfig(unsigned cache, unsigned op, unsigned result) {
+    return cache | (op << 8) | (result << 16);
+}
+
+PerfCounters::PerfCounters() {
+    const pair<unsigned, unsigned long long> events[HARDWARE_COUNTER_COUNT] = {
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HW_CACHE, cacheConfig(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    };
+    // the first counter that opens leads the group
+    int leader = -1;
+    for (int i = 0; i < HARDWARE_COUNTER_COUNT; i++) {
+        fds[i] = openCounter(events[i].first, events[i].second, leader);
+        if (leader < 0) leader = fds[i];
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    for (int fd : fds) {
+        if (fd >= 0) close(fd);
+    }
+}
+
+void PerfCounters::start() {
+    for (int i = 0; i < HARDWARE_COUNTER_COUNT; i++) {
+        if (fds[i] < 0) continue;
+        if (read(fds[i], &started[i], sizeof(Reading)) != sizeof(Reading))
+            started[i] = {};
+        ioctl(fds[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+vector<BenchmarkMetric> PerfCounters::stop() {
+    vector<BenchmarkMetric> metrics;
+    for (int i = 0; i < HARDWARE_COUNTER_COUNT; i++) {
+        if (fds[i] < 0) continue;
+        ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+    }
+    for (int i = 0; i < HARDWARE_COUNTER_COUNT; i++) {
+        Reading reading;
+        if (fds[i] < 0 || read(fds[i], &reading, sizeof(reading)) != sizeof(reading)) continue;
+        unsigned long long value = reading.value - started[i].value;
+        unsigned long long enabled = reading.timeEnabled - started[i].timeEnabled;
+        unsigned long long running = reading.timeRunning - started[i].timeRunning;
+        // never scheduled on the CPU, there is no count to scale
+        if (running == 0) continue;
+        double count = (double) value * enabled / running;
+        metrics.push_back({hardwareCounterName((HardwareCounter) i), count});
+    }
+    return metrics;
+}
+#else
+PerfCounters::PerfCounters() {
+    for (int& fd : fds)
+        fd = -1;
+}
+
+PerfCounters::~PerfCounters() {}
+
+void PerfCounters::start() {}
+
+vector<BenchmarkMetric> PerfCounters::stop() {
+    return {};
+}
+#endif
+
+bool PerfCounters::isAvailable() {
+    for (int fd : fds) {
+        if (fd >= 0) return true;
+    }
+    return false;
+}
+
+vector<BenchmarkMetric> measureHardwareCounters(const BenchmarkCase& benchmarkCase, const vector<int>& input) {
+    // opened once, reopening five counters for every case costs more than some of the sorts
+    static PerfCounters counters;
+    if (!counters.isAvailable()) return {};
+
+    vector<int> work(input);
+    counters.start();
+    benchmarkCase.run(work.data(), work.size());
+    return counters.stop();
+}
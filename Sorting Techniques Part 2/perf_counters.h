@@ -0,0 +1,92 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <utility>
+#include <vector>
+#include "benchmark.h"
+
+enum HardwareCounter { CYCLES_COUNTER, INSTRUCTIONS_COUNTER, L1D_MISSES_COUNTER, LLC_MISSES_COUNTER, BRANCH_MISSES_COUNTER };
+const int HARDWARE_COUNTER_COUNT = 5;
+
+// Linux perf_event_open counters for the calling thread (user space only, so perf_event_paranoid up to 2 is enough)
+// a counter the kernel or the CPU does not offer (VMs, containers, other OSes) is simply left out of the results,
+// worker threads of the parallel sorts are not counted.
+// The counters are opened as one group so they count over the same time, one that does not fit the group is opened
+// on its own. If the CPU has fewer counters than events the kernel multiplexes them, so every count is scaled up by
+// the time it was enabled over the time it was actually counting
+class PerfCounters {
+private:
+    // what read() returns for one counter, the times are only reset when the counter is opened
+    struct Reading {
+        unsigned long long value;
+        unsigned long long timeEnabled;
+        unsigned long long timeRunning;
+    };
+
+    int fds[HARDWARE_COUNTER_COUNT];
+    // readings at start(), stop() scales the difference
+    Reading started[HARDWARE_COUNTER_COUNT];
+
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool isAvailable();
+    void start();
+    // the counts since start() as metrics, one per available counter
+    std::vector<BenchmarkMetric> stop();
+};
+
+const char* hardwareCounterName(HardwareCounter counter);
+
+// hardware counters around one run of any benchmark case (use as BenchmarkOptions::instrument)
+std::vector<BenchmarkMetric> measureHardwareCounters(const BenchmarkCase& benchmarkCase, const std::vector<int>& input);
+
+// element moves made by the generic sorts on CountedInt elements: every copy or move into an element (construction or
+// assignment), so a swap is 3 moves and insertion or merge sorts that shift elements by assignment are counted too
+inline thread_local long long countedMoves = 0;
+
+struct CountedInt {
+    int value;
+
+    CountedInt() : value(0) {}
+    CountedInt(int value) : value(value) {}
+    CountedInt(const CountedInt& other) : value(other.value) { countedMoves++; }
+    CountedInt& operator=(const CountedInt& other) {
+        value = other.value;
+        countedMoves++;
+        return *this;
+    }
+};
+
+// comparator for the generic sorts that counts how often it is called
+struct CountingCompare {
+    long long* comparisons;
+
+    bool operator()(int a, int b) const {
+        ++*comparisons;
+        return a < b;
+    }
+};
+
+// comparisons and element moves of one generic sort on a copy of the input, sort is called as sort(first, last, comp, proj)
+template <class Sort>
+MetricCollector operationCounter(Sort sort) {
+    return [sort](const std::vector<int>& input) {
+        std::vector<CountedInt> elements;
+        elements.reserve(input.size());
+        for (int value : input)
+            elements.push_back({value});
+
+        long long comparisons = 0;
+        // copying the input in above is not part of the sort
+        countedMoves = 0;
+        sort(elements.begin(), elements.end(), CountingCompare{&comparisons}, &CountedInt::value);
+        return std::vector<BenchmarkMetric>{{"comparisons", (double) comparisons}, {"moves", (double) countedMoves}};
+    };
+}
+
+#endif //PERF_COUNTERS_H
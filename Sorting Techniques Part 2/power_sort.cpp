@@ -0,0 +1,267 @@
+#include "power_sort.h"
+#include "sorting_techniques_part1.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+using namespace std;
+
+// a sorted stretch arr[start, start + length) waiting on the run stack
+struct Run {
+    int start;
+    int length;
+    int power;
+};
+
+// merge scratch space and the galloping threshold, which carries over from one merge to the next
+struct MergeState {
+    vector<int> buffer;
+    int minGallop = MIN_GALLOP;
+};
+
+// TimSort's minrun: n / minRun is a power of two or just below one, so the first merges are balanced
+static int computeMinRun(int n) {
+    int extra = 0;
+    while (n >= POWER_SORT_MIN_MERGE) {
+        extra |= n & 1;
+        n >>= 1;
+    }
+    return n + extra;
+}
+
+// length of the run starting at start, a strictly descending one is reversed so equal keys keep their order
+static int countRun(int arr[], int start, int size) {
+    int end = start + 1;
+    if (end == size) return 1;
+    if (arr[end] < arr[start]) {
+        while (end < size && arr[end] < arr[end - 1])
+            end++;
+        reverse(arr + start, arr + end);
+    } else {
+        while (end < size && arr[end] >= arr[end - 1])
+            end++;
+    }
+    return end - start;
+}
+
+// depth of the node between the runs [s1, s1 + n1) and [s1 + n1, s1 + n1 + n2) in the nearly balanced merge tree
+// over [0, n): the first bit where the two run midpoints (as fractions of n) differ
+static int nodePower(long long s1, long long n1, long long n2, long long n) {
+    long long a = 2 * s1 + n1;
+    long long b = a + n1 + n2;
+    int power = 0;
+    while (true) {
+        power++;
+        if (a >= n) {
+            a -= n;
+            b -= n;
+        } else if (b >= n) {
+            break;
+        }
+        a <<= 1;
+        b <<= 1;
+    }
+    return power;
+}
+
+// where key goes in the sorted arr[0, n): the first element >= key, or > key if after is true (equal keys stay in front)
+// probes 0, 1, 3, 7, ... from the front and binary searches the last gap, so it costs O(log distance)
+static int gallopFromFront(int key, const int arr[], int n, bool after) {
+    auto before = [&](int value) { return after ? value <= key : value < key; };
+    if (n == 0 || !before(arr[0])) return 0;
+
+    int lastOffset = 0;
+    int offset = 1;
+    while (offset < n && before(arr[offset])) {
+        lastOffset = offset;
+        offset = offset * 2 + 1;
+    }
+    int low = lastOffset + 1;
+    int high = min(offset, n);
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (before(arr[mid]))
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return low;
+}
+
+// same position as gallopFromFront but probes from the back, for merges running right to left
+static int gallopFromBack(int key, const int arr[], int n, bool after) {
+    auto before = [&](int value) { return after ? value <= key : value < key; };
+    if (n == 0 || before(arr[n - 1])) return n;
+
+    int lastOffset = 0;
+    int offset = 1;
+    while (offset < n && !before(arr[n - 1 - offset])) {
+        lastOffset = offset;
+        offset = offset * 2 + 1;
+    }
+    int low = max(0, n - offset);
+    int high = n - 1 - lastOffset;
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (before(arr[mid]))
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return low;
+}
+
+// merges arr[0, n1) with arr[n1, n1 + n2) front to back, only the left run is moved out to the buffer
+static void mergeLow(int arr[], int n1, int n2, MergeState& state) {
+    int* left = state.buffer.data();
+    memcpy(left, arr, n1 * sizeof(int));
+    int i = 0;
+    int j = n1;
+    int end = n1 + n2;
+    int out = 0;
+
+    while (i < n1 && j < end) {
+        // one element at a time until a run wins minGallop times in a row
+        int leftWins = 0;
+        int rightWins = 0;
+        while (i < n1 && j < end && leftWins < state.minGallop && rightWins < state.minGallop) {
+            if (arr[j] < left[i]) {
+                arr[out++] = arr[j++];
+                rightWins++;
+                leftWins = 0;
+            } else {
+                arr[out++] = left[i++];
+                leftWins++;
+                rightWins = 0;
+            }
+        }
+
+        // then copy whole stretches found by galloping while they stay long
+        while (i < n1 && j < end) {
+            int leftCount = gallopFromFront(arr[j], left + i, n1 - i, true);
+            memcpy(arr + out, left + i, leftCount * sizeof(int));
+            out += leftCount;
+            i += leftCount;
+            if (i == n1) break;
+
+            int rightCount = gallopFromFront(left[i], arr + j, end - j, false);
+            memmove(arr + out, arr + j, rightCount * sizeof(int));
+            out += rightCount;
+            j += rightCount;
+
+            if (leftCount < MIN_GALLOP && rightCount < MIN_GALLOP) {
+                state.minGallop++;
+                break;
+            }
+            state.minGallop = max(1, state.minGallop - 1);
+        }
+    }
+    // whatever is left of the right run is already in place
+    memcpy(arr + out, left + i, (n1 - i) * sizeof(int));
+}
+
+// merges arr[0, n1) with arr[n1, n1 + n2) back to front, only the right run is moved out to the buffer
+static void mergeHigh(int arr[], int n1, int n2, MergeState& state) {
+    int* right = state.buffer.data();
+    memcpy(right, arr + n1, n2 * sizeof(int));
+    int i = n1;
+    int j = n2;
+    int out = n1 + n2;
+
+    // i and j count what is left of each run, so the next candidates are arr[i - 1] and right[j - 1]
+    while (i > 0 && j > 0) {
+        int leftWins = 0;
+        int rightWins = 0;
+        while (i > 0 && j > 0 && leftWins < state.minGallop && rightWins < state.minGallop) {
+            // on equal keys the right one goes last
+            if (right[j - 1] < arr[i - 1]) {
+                arr[--out] = arr[--i];
+                leftWins++;
+                rightWins = 0;
+            } else {
+                arr[--out] = right[--j];
+                rightWins++;
+                leftWins = 0;
+            }
+        }
+
+        while (i > 0 && j > 0) {
+            int rightCount = j - gallopFromBack(arr[i - 1], right, j, false);
+            out -= rightCount;
+            j -= rightCount;
+            memcpy(arr + out, right + j, rightCount * sizeof(int));
+            if (j == 0) break;
+
+            int leftCount = i - gallopFromBack(right[j - 1], arr, i, true);
+            out -= leftCount;
+            i -= leftCount;
+            memmove(arr + out, arr + i, leftCount * sizeof(int));
+
+            if (leftCount < MIN_GALLOP && rightCount < MIN_GALLOP) {
+                state.minGallop++;
+                break;
+            }
+            state.minGallop = max(1, state.minGallop - 1);
+        }
+    }
+    memcpy(arr, right, j * sizeof(int));
+}
+
+// merges the neighbouring runs arr[0, n1) and arr[n1, n1 + n2)
+static void mergeRuns(int arr[], int n1, int n2, MergeState& state) {
+    // the start of the left run that is <= the first right element and the end of the right run that is >= the last
+    // left element are already in place
+    int skip = gallopFromFront(arr[n1], arr, n1, true);
+    arr += skip;
+    n1 -= skip;
+    if (n1 == 0) return;
+    n2 = gallopFromBack(arr[n1 - 1], arr + n1, n2, false);
+    if (n2 == 0) return;
+
+    if (n1 <= n2)
+        mergeLow(arr, n1, n2, state);
+    else
+        mergeHigh(arr, n1, n2, state);
+}
+
+// the next run from start, extended to minRun elements (or the end of the array) with insertion sort
+static Run nextRun(int arr[], int start, int size, int minRun) {
+    int length = countRun(arr, start, size);
+    if (length < minRun) {
+        length = min(minRun, size - start);
+        // the first part is sorted already, so each new element only walks back over the ones it belongs before
+        insertionSort(arr + start, length);
+    }
+    return {start, length, 0};
+}
+
+void powerSort(int arr[], int size) {
+    if (size < 2) return;
+    MergeState state;
+    state.buffer.resize(size / 2);
+    int minRun = computeMinRun(size);
+
+    // runs on the stack have strictly increasing powers from bottom to top
+    vector<Run> stack;
+    Run current = nextRun(arr, 0, size, minRun);
+    while (current.start + current.length < size) {
+        Run next = nextRun(arr, current.start + current.length, size, minRun);
+        int power = nodePower(current.start, current.length, next.length, size);
+        // everything deeper in the merge tree than the node between current and next has to be merged first
+        while (!stack.empty() && stack.back().power > power) {
+            Run top = stack.back();
+            stack.pop_back();
+            mergeRuns(arr + top.start, top.length, current.length, state);
+            current = {top.start, top.length + current.length, 0};
+        }
+        current.power = power;
+        stack.push_back(current);
+        current = next;
+    }
+    while (!stack.empty()) {
+        Run top = stack.back();
+        stack.pop_back();
+        mergeRuns(arr + top.start, top.length, current.length, state);
+        current = {top.start, top.length + current.length, 0};
+    }
+}
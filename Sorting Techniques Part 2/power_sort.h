@@ -0,0 +1,14 @@
+#ifndef POWER_SORT_H
+#define POWER_SORT_H
+
+// runs shorter than this are never searched for, every run found is extended to minRun (32..64) with insertionSort
+const int POWER_SORT_MIN_MERGE = 64;
+// consecutive wins by one run before a merge switches to galloping, adapted per merge like TimSort
+const int MIN_GALLOP = 7;
+
+// Natural merge sort: finds the ascending (or strictly descending, reversed in place) runs already in the array
+// and merges neighbouring runs in the order given by the powersort merge policy, stable and O(n) on sorted
+// or reversed input, O(nlogn) worst case with a buffer of at most size/2 ints
+void powerSort(int arr[], int size);
+
+#endif //POWER_SORT_H
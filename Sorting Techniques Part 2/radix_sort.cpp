@@ -0,0 +1,59 @@
+#include "radix_sort.h"
+#include <cstring>
+#include <vector>
+
+using namespace std;
+
+const int RADIX_BITS = 8;
+const int RADIX_BUCKETS = 1 << RADIX_BITS;
+const int RADIX_PASSES = 32 / RADIX_BITS;
+
+// flipping the sign bit maps INT_MIN..INT_MAX onto 0..UINT_MAX in the same order, so negatives sort first
+static unsigned toRadixKey(int value) {
+    return (unsigned) value ^ 0x80000000u;
+}
+
+// LSD radix sort - O(n) for fixed width keys, 4 stable counting passes over 8 bit digits
+void radixSort(int arr[], int size) {
+    if (size < 2) return;
+
+    // one read of the input fills the histograms of all passes at once
+    unsigned counts[RADIX_PASSES][RADIX_BUCKETS];
+    memset(counts, 0, sizeof(counts));
+    for (int i = 0; i < size; i++) {
+        unsigned key = toRadixKey(arr[i]);
+        for (int pass = 0; pass < RADIX_PASSES; pass++)
+            counts[pass][(key >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++;
+    }
+
+    // ping-pong between the array and one buffer instead of copying back after every pass
+    vector<int> buffer(size);
+    int* src = arr;
+    int* dst = buffer.data();
+
+    for (int pass = 0; pass < RADIX_PASSES; pass++) {
+        int shift = pass * RADIX_BITS;
+
+        // all keys share this digit (e.g. the high byte of small numbers) so the pass would not move anything
+        unsigned firstDigit = (toRadixKey(src[0]) >> shift) & (RADIX_BUCKETS - 1);
+        if (counts[pass][firstDigit] == (unsigned) size) continue;
+
+        // prefix sums turn the counts into the starting offset of every bucket
+        unsigned offsets[RADIX_BUCKETS];
+        unsigned sum = 0;
+        for (int digit = 0; digit < RADIX_BUCKETS; digit++) {
+            offsets[digit] = sum;
+            sum += counts[pass][digit];
+        }
+
+        for (int i = 0; i < size; i++) {
+            unsigned digit = (toRadixKey(src[i]) >> shift) & (RADIX_BUCKETS - 1);
+            dst[offsets[digit]++] = src[i];
+        }
+        swap(src, dst);
+    }
+
+    // an odd number of passes leaves the result in the buffer
+    if (src != arr)
+        memcpy(arr, src, size * sizeof(int));
+}
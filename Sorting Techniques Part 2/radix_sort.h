@@ -0,0 +1,6 @@
+#ifndef RADIX_SORT_H
+#define RADIX_SORT_H
+
+void radixSort(int arr[], int size);
+
+#endif //RADIX_SORT_H
@@ -0,0 +1,173 @@
+#include "simd_sort.h"
+#include "sorting_techniques_part1.h"
+#include "sorting_techniques_part2.h"
+#include <climits>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SIMD_SORT_X86
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+#ifdef SIMD_SORT_X86
+// the kernels are compiled for AVX2 without raising the baseline of the whole program, the CPU is checked at runtime
+#define AVX2_TARGET __attribute__((target("avx2")))
+
+// one layer of a sorting network: every lane is compared with the lane named in partner,
+// lanes whose bit is set in MAX_LANES keep the bigger value and the others keep the smaller one
+template <int MAX_LANES>
+AVX2_TARGET static inline __m256i compareExchange(__m256i v, __m256i partner) {
+    __m256i w = _mm256_permutevar8x32_epi32(v, partner);
+    return _mm256_blend_epi32(_mm256_min_epi32(v, w), _mm256_max_epi32(v, w), MAX_LANES);
+}
+
+// optimal 19 comparator / 6 layer network for 8 keys
+AVX2_TARGET static inline __m256i sort8(__m256i v) {
+    v = compareExchange<0xCC>(v, _mm256_setr_epi32(2, 3, 0, 1, 6, 7, 4, 5));
+    v = compareExchange<0xF0>(v, _mm256_setr_epi32(4, 5, 6, 7, 0, 1, 2, 3));
+    v = compareExchange<0xAA>(v, _mm256_setr_epi32(1, 0, 3, 2, 5, 4, 7, 6));
+    v = compareExchange<0x30>(v, _mm256_setr_epi32(0, 1, 4, 5, 2, 3, 6, 7));
+    v = compareExchange<0x50>(v, _mm256_setr_epi32(0, 4, 2, 6, 1, 5, 3, 7));
+    v = compareExchange<0x54>(v, _mm256_setr_epi32(0, 2, 1, 4, 3, 6, 5, 7));
+    return v;
+}
+
+// sorts a bitonic sequence of 8 keys (half cleaners at distance 4, 2 and 1)
+AVX2_TARGET static inline __m256i bitonicMerge8(__m256i v) {
+    v = compareExchange<0xF0>(v, _mm256_setr_epi32(4, 5, 6, 7, 0, 1, 2, 3));
+    v = compareExchange<0xCC>(v, _mm256_setr_epi32(2, 3, 0, 1, 6, 7, 4, 5));
+    v = compareExchange<0xAA>(v, _mm256_setr_epi32(1, 0, 3, 2, 5, 4, 7, 6));
+    return v;
+}
+
+// merges two sorted vectors: lo gets the 8 smallest keys and hi the 8 biggest, both sorted
+AVX2_TARGET static inline void merge2x8(__m256i a, __m256i b, __m256i& lo, __m256i& hi) {
+    // a ascending followed by b descending is bitonic, so its min/max halves are bitonic too
+    b = _mm256_permutevar8x32_epi32(b, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+    lo = bitonicMerge8(_mm256_min_epi32(a, b));
+    hi = bitonicMerge8(_mm256_max_epi32(a, b));
+}
+
+// any block of up to 16 keys: missing lanes are padded with INT_MAX so they sort to the end and are never stored
+AVX2_TARGET static void sortSmallBlockAvx2(int arr[], int size) {
+    if (size > SIMD_BLOCK_SIZE) {
+        insertionSort(arr, size);
+        return;
+    }
+    __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i fill = _mm256_set1_epi32(INT_MAX);
+    __m256i maskLow = _mm256_cmpgt_epi32(_mm256_set1_epi32(size), lanes);
+    __m256i maskHigh = _mm256_cmpgt_epi32(_mm256_set1_epi32(size - 8), lanes);
+
+    __m256i a = _mm256_blendv_epi8(fill, _mm256_maskload_epi32(arr, maskLow), maskLow);
+    __m256i b = _mm256_blendv_epi8(fill, _mm256_maskload_epi32(arr + 8, maskHigh), maskHigh);
+    __m256i lo, hi;
+    merge2x8(sort8(a), sort8(b), lo, hi);
+
+    _mm256_maskstore_epi32(arr, maskLow, lo);
+    _mm256_maskstore_epi32(arr + 8, maskHigh, hi);
+}
+
+// bitonic merge of src[low..mid] and src[mid+1..high] into dst, 8 keys per step
+AVX2_TARGET static void simdMergeIntoAvx2(const int src[], int dst[], int low, int mid, int high) {
+    const int* a = src + low;
+    const int* aEnd = src + mid + 1;
+    const int* b = src + mid + 1;
+    const int* bEnd = src + high + 1;
+    int* out = dst + low;
+
+    if (aEnd - a < 8 || bEnd - b < 8) {
+        mergeInto(src, dst, low, mid, high);
+        return;
+    }
+
+    __m256i lo, hi;
+    merge2x8(_mm256_loadu_si256((const __m256i*) a), _mm256_loadu_si256((const __m256i*) b), lo, hi);
+    a += 8;
+    b += 8;
+    _mm256_storeu_si256((__m256i*) out, lo);
+    out += 8;
+
+    // hi keeps the 8 biggest keys seen so far, the next 8 always come from the run with the smaller head
+    while (true) {
+        bool takeA = b == bEnd || (a < aEnd && *a <= *b);
+        const int*& next = takeA ? a : b;
+        const int* nextEnd = takeA ? aEnd : bEnd;
+        if (nextEnd - next < 8) break;
+
+        merge2x8(hi, _mm256_loadu_si256((const __m256i*) next), lo, hi);
+        next += 8;
+        _mm256_storeu_si256((__m256i*) out, lo);
+        out += 8;
+    }
+
+    // finish with a scalar merge of the 8 keys still in hi and what is left of both runs
+    int rest[8];
+    _mm256_storeu_si256((__m256i*) rest, hi);
+    int r = 0;
+    while (r < 8 || a < aEnd || b < bEnd) {
+        if (r < 8 && (a == aEnd || rest[r] <= *a) && (b == bEnd || rest[r] <= *b))
+            *out++ = rest[r++];
+        else if (a < aEnd && (b == bEnd || *a <= *b))
+            *out++ = *a++;
+        else
+            *out++ = *b++;
+    }
+}
+
+static bool cpuHasAvx2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+#else
+static bool cpuHasAvx2() {
+    return false;
+}
+#endif
+
+static void sortSmallBlockScalar(int arr[], int size) {
+    insertionSort(arr, size);
+}
+
+// picked once from CPUID, the scalar versions are the fallback on CPUs (or architectures) without AVX2
+static const bool hasAvx2 = cpuHasAvx2();
+#ifdef SIMD_SORT_X86
+static void (*const sortSmallBlockKernel)(int[], int) = hasAvx2 ? sortSmallBlockAvx2 : sortSmallBlockScalar;
+static void (*const mergeIntoKernel)(const int[], int[], int, int, int) = hasAvx2 ? simdMergeIntoAvx2 : mergeInto;
+#else
+static void (*const sortSmallBlockKernel)(int[], int) = sortSmallBlockScalar;
+static void (*const mergeIntoKernel)(const int[], int[], int, int, int) = mergeInto;
+#endif
+
+bool simdSortAvailable() {
+    return hasAvx2;
+}
+
+void sortSmallBlock(int arr[], int size) {
+    sortSmallBlockKernel(arr, size);
+}
+
+void simdMergeInto(const int src[], int dst[], int low, int mid, int high) {
+    mergeIntoKernel(src, dst, low, mid, high);
+}
+
+// same ping-pong recursion as hybridMergeSortInto with the SIMD kernels at the leaves and merges
+static void simdHybridMergeSortInto(int src[], int dst[], int left, int right, int THRESHOLD) {
+    if (right - left + 1 <= THRESHOLD || left >= right) {
+        sortSmallBlockKernel(dst + left, right - left + 1);
+        return;
+    }
+    int mid = left + (right - left) / 2;
+    simdHybridMergeSortInto(dst, src, left, mid, THRESHOLD);
+    simdHybridMergeSortInto(dst, src, mid + 1, right, THRESHOLD);
+    mergeIntoKernel(src, dst, left, mid, right);
+}
+
+void simdHybridMergeSort(int arr[], int left, int right, int THRESHOLD) {
+    if (left >= right) return;
+    int size = right - left + 1;
+    vector<int> buffer(arr + left, arr + right + 1);
+    simdHybridMergeSortInto(buffer.data(), arr + left, 0, size - 1, THRESHOLD);
+}
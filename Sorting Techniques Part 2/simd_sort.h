@@ -0,0 +1,12 @@
+#ifndef SIMD_SORT_H
+#define SIMD_SORT_H
+
+// largest block the AVX2 sorting network handles in registers (two vectors of 8 ints)
+const int SIMD_BLOCK_SIZE = 16;
+
+bool simdSortAvailable();
+void sortSmallBlock(int arr[], int size);
+void simdMergeInto(const int src[], int dst[], int low, int mid, int high);
+void simdHybridMergeSort(int arr[], int left, int right, int THRESHOLD = SIMD_BLOCK_SIZE);
+
+#endif //SIMD_SORT_H
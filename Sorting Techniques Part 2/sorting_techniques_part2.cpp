@@ -0,0 +1,211 @@
+#include "sorting_techniques_part2.h"
+#include "sorting_techniques_part1.h"
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+void mergeSort(int arr[], int low, int high) {
+    if (low >= high) return;
+    int mid = low + (high - low) / 2;
+    mergeSort(arr, low, mid);
+    mergeSort(arr, mid + 1, high);
+    merge(arr, low, mid, high);
+}
+
+void merge(int arr[], int low, int mid, int high) {
+    int size = high - low + 1;
+    int temp[size];
+    int index = 0;
+    int left = low;
+    int right = mid + 1;
+    while (left <= mid && right <= high) {
+        if (arr[left] <= arr[right]) {
+            temp[index++] = arr[left++];
+        }
+        else {
+            temp[index++] = arr[right++];
+        }
+    }
+    while (left <= mid) {
+        temp[index++] = arr[left++];
+    }
+    while (right <= high) {
+        temp[index++] = arr[right++];
+    }
+    for (int i = 0; i < size; i++) {
+        arr[low + i] = temp[i];
+    }
+}
+
+void quickSort(int arr[], int low,int high, PartitionScheme scheme) {
+    if (low < high) {
+        int pivot = partitionWith(scheme,arr,low,high);
+        quickSort(arr,low,pivot-1,scheme);
+        quickSort(arr,pivot+1,high,scheme);
+    }
+}
+
+// rand() shares one locked state between threads, so every thread draws its pivots from its own engine
+static int randomPivotIndex(int low, int high) {
+    static thread_local minstd_rand engine(rand());
+    return low + engine() % (high - low + 1);
+}
+
+int partition(int arr[], int low, int high) {
+    int randomIndex = randomPivotIndex(low, high);
+    swap(arr[randomIndex], arr[high]);
+    int pivot = arr[high];
+    int i = low - 1;
+    for (int j = low; j <= high - 1; j++) {
+        if (arr[j] <= pivot) {
+            i += 1;
+            swap(arr[i], arr[j]);
+        }
+    }
+    i += 1;
+    swap(arr[i], arr[high]);
+    return i;
+}
+
+// BlockQuicksort partition - same result as partition() but without a data dependent branch per element
+// each side scans a block of PARTITION_BLOCK_SIZE elements and only records the offsets of misplaced ones
+// (the comparison result is added to a counter instead of branched on), then the recorded pairs get swapped
+int blockPartition(int arr[], int low, int high) {
+    int randomIndex = randomPivotIndex(low, high);
+    swap(arr[randomIndex], arr[high]);
+    int pivot = arr[high];
+
+    int offsetsLeft[PARTITION_BLOCK_SIZE];
+    int offsetsRight[PARTITION_BLOCK_SIZE];
+    int startLeft = 0, countLeft = 0;
+    int startRight = 0, countRight = 0;
+    int left = low;
+    int right = high - 1;
+
+    while (right - left + 1 > 2 * PARTITION_BLOCK_SIZE) {
+        // elements of the left block that belong on the right
+        if (countLeft == 0) {
+            startLeft = 0;
+            for (int i = 0; i < PARTITION_BLOCK_SIZE; i++) {
+                offsetsLeft[countLeft] = i;
+                countLeft += (arr[left + i] >= pivot);
+            }
+        }
+        // elements of the right block that belong on the left
+        if (countRight == 0) {
+            startRight = 0;
+            for (int i = 0; i < PARTITION_BLOCK_SIZE; i++) {
+                offsetsRight[countRight] = i;
+                countRight += (arr[right - i] <= pivot);
+            }
+        }
+
+        int count = min(countLeft, countRight);
+        for (int i = 0; i < count; i++)
+            swap(arr[left + offsetsLeft[startLeft + i]], arr[right - offsetsRight[startRight + i]]);
+
+        countLeft -= count;
+        countRight -= count;
+        startLeft += count;
+        startRight += count;
+        if (countLeft == 0) left += PARTITION_BLOCK_SIZE;
+        if (countRight == 0) right -= PARTITION_BLOCK_SIZE;
+    }
+
+    // everything before left is <= pivot and everything after right is >= pivot
+    // the last two blocks or less get a Hoare pass, its scans stop on keys equal to the pivot so duplicates still split evenly
+    int i = left;
+    int j = right;
+    while (true) {
+        while (i <= j && arr[i] < pivot) i++;
+        while (i <= j && arr[j] > pivot) j--;
+        if (i >= j) break;
+        swap(arr[i++], arr[j--]);
+    }
+    swap(arr[i], arr[high]);
+    return i;
+}
+
+int partitionWith(PartitionScheme scheme, int arr[], int low, int high) {
+    if (scheme == BLOCK_PARTITION)
+        return blockPartition(arr, low, high);
+    return partition(arr, low, high);
+}
+
+void hybridMergeSort(int arr[], int left, int right,int THRESHOLD) {
+    if (right - left + 1 <= THRESHOLD) {
+        insertionSort(arr + left, right - left + 1);
+        return;
+    }
+    if (left < right) {
+        int mid = left + (right - left) / 2;
+        hybridMergeSort(arr, left, mid,THRESHOLD);
+        hybridMergeSort(arr, mid + 1, right,THRESHOLD);
+        merge(arr, left, mid, right);
+    }
+}
+
+int quickSelect(int arr[], int low, int high, int k, PartitionScheme scheme){
+
+    if(low<=high){
+        int pivot=partitionWith(scheme,arr,low,high);
+        //checks if pivot found equals k
+        if(pivot==k-1)
+            return arr[pivot];
+        //checks if k less than pivot takes left subarray
+        if(pivot>k-1)
+            return quickSelect(arr,low,pivot-1,k,scheme);
+        //takes the right subarray (bigger than pivot)
+        return quickSelect(arr,pivot+1,high,k,scheme);
+    }
+    //error case
+    return -1;
+
+}
+
+// merges the sorted halves src[low..mid] and src[mid+1..high] into dst[low..high]
+void mergeInto(const int src[], int dst[], int low, int mid, int high) {
+    int index = low;
+    int left = low;
+    int right = mid + 1;
+    while (left <= mid && right <= high) {
+        if (src[left] <= src[right]) {
+            dst[index++] = src[left++];
+        }
+        else {
+            dst[index++] = src[right++];
+        }
+    }
+    while (left <= mid) {
+        dst[index++] = src[left++];
+    }
+    while (right <= high) {
+        dst[index++] = src[right++];
+    }
+}
+
+// src and dst hold the same elements on entry, the sorted range ends up in dst
+// the halves are sorted into src (using dst as their scratch space) and then merged back into dst
+void hybridMergeSortInto(int src[], int dst[], int left, int right, int THRESHOLD) {
+    if (right - left + 1 <= THRESHOLD || left >= right) {
+        insertionSort(dst + left, right - left + 1);
+        return;
+    }
+    int mid = left + (right - left) / 2;
+    hybridMergeSortInto(dst, src, left, mid, THRESHOLD);
+    hybridMergeSortInto(dst, src, mid + 1, right, THRESHOLD);
+    mergeInto(src, dst, left, mid, right);
+}
+
+void bufferedMergeSort(int arr[], int low, int high) {
+    bufferedHybridMergeSort(arr, low, high, 1);
+}
+
+void bufferedHybridMergeSort(int arr[], int left, int right, int THRESHOLD) {
+    if (left >= right) return;
+    int size = right - left + 1;
+    vector<int> buffer(arr + left, arr + right + 1);
+    hybridMergeSortInto(buffer.data(), arr + left, 0, size - 1, THRESHOLD);
+}
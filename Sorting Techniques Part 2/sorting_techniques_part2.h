@@ -0,0 +1,29 @@
+#ifndef SORTING_TECHNIQUES_PART2_H
+#define SORTING_TECHNIQUES_PART2_H
+
+// Merge Sort
+void mergeSort(int arr[], int low, int high);
+void merge(int arr[], int low, int mid, int high);
+
+// Quick Sort
+// LOMUTO_PARTITION is the original partition(), BLOCK_PARTITION is the branchless blockPartition()
+enum PartitionScheme { LOMUTO_PARTITION, BLOCK_PARTITION };
+// elements buffered per side by blockPartition
+const int PARTITION_BLOCK_SIZE = 128;
+
+void quickSort(int arr[], int low, int high, PartitionScheme scheme = LOMUTO_PARTITION);
+int partition(int arr[], int low, int high);
+int blockPartition(int arr[], int low, int high);
+int partitionWith(PartitionScheme scheme, int arr[], int low, int high);
+
+// Part 2 - Hybrid Merge Sort (Merge Sort with Insertion Sort) and Quick Select (Quick Sort with Selection)
+void hybridMergeSort(int arr[], int left, int right,int THRESHOLD);
+int quickSelect(int arr[], int low, int high, int k, PartitionScheme scheme = LOMUTO_PARTITION);
+
+// Merge Sort with one scratch buffer allocated up front, levels alternate between arr and the buffer so nothing is copied back
+void mergeInto(const int src[], int dst[], int low, int mid, int high);
+void hybridMergeSortInto(int src[], int dst[], int left, int right, int THRESHOLD);
+void bufferedMergeSort(int arr[], int low, int high);
+void bufferedHybridMergeSort(int arr[], int left, int right, int THRESHOLD);
+
+#endif //SORTING_TECHNIQUES_PART2_H
@@ -0,0 +1,117 @@
+#include "threshold_tuning.h"
+#include "benchmark.h"
+#include "sorting_techniques_part2.h"
+#include "simd_sort.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+
+string cpuModelName() {
+    ifstream cpuinfo("/proc/cpuinfo");
+    string line;
+    while (getline(cpuinfo, line)) {
+        if (line.rfind("model name", 0) == 0) {
+            size_t colon = line.find(':');
+            if (colon != string::npos && colon + 2 <= line.size())
+                return line.substr(colon + 2);
+        }
+    }
+    return "unknown";
+}
+
+// cutoff whose medians summed over all calibration sizes (each as a fraction of its slowest candidate) is the smallest
+static int fastestThreshold(const string& name, const vector<int>& candidates, void (*sort)(int[], int, int)) {
+    BenchmarkOptions options;
+    options.timeBudgetMs = 500;
+    vector<double> score(candidates.size(), 0);
+
+    for (int size : CALIBRATION_SIZES) {
+        vector<int> input = generateInput(RANDOM_INPUT, size, options.seed);
+        vector<double> medians;
+        for (int threshold : candidates) {
+            BenchmarkCase thresholdCase = {name, [sort, threshold](int arr[], int n) { sort(arr, n, threshold); }};
+            medians.push_back(runBenchmark(thresholdCase, input, RANDOM_INPUT, options).medianMs);
+        }
+        double slowest = *max_element(medians.begin(), medians.end());
+        for (size_t i = 0; i < medians.size(); i++)
+            score[i] += medians[i] / slowest;
+    }
+
+    size_t best = min_element(score.begin(), score.end()) - score.begin();
+    printf("Fastest threshold for %s is %d\n", name.c_str(), candidates[best]);
+    return candidates[best];
+}
+
+ThresholdProfile calibrateThresholds() {
+    ThresholdProfile profile;
+    profile.cpu = cpuModelName();
+    profile.hybridMergeThreshold = fastestThreshold("Buffered Hybrid Merge Sort", CANDIDATE_THRESHOLDS,
+                                                    [](int arr[], int size, int threshold) {
+        bufferedHybridMergeSort(arr, 0, size - 1, threshold);
+    });
+    // blocks bigger than the sorting network fall back to insertion sort, a cutoff above it would time that instead
+    vector<int> simdCandidates;
+    for (int threshold : CANDIDATE_THRESHOLDS) {
+        if (threshold <= SIMD_BLOCK_SIZE)
+            simdCandidates.push_back(threshold);
+    }
+    profile.simdMergeThreshold = fastestThreshold("SIMD Hybrid Merge Sort", simdCandidates,
+                                                  [](int arr[], int size, int threshold) {
+        simdHybridMergeSort(arr, 0, size - 1, threshold);
+    });
+    return profile;
+}
+
+// one "key value" pair per line, the cpu name is the rest of its line
+bool loadThresholdProfile(const string& path, ThresholdProfile& profile) {
+    ifstream file(path);
+    if (!file.is_open()) return false;
+
+    ThresholdProfile loaded;
+    string key;
+    while (file >> key) {
+        if (key == "cpu") {
+            file >> ws;
+            getline(file, loaded.cpu);
+        } else if (key == "hybridMergeThreshold") {
+            file >> loaded.hybridMergeThreshold;
+        } else if (key == "simdMergeThreshold") {
+            file >> loaded.simdMergeThreshold;
+        } else {
+            string rest;
+            getline(file, rest);
+        }
+    }
+    // a SIMD cutoff above the network size is from a calibration that timed insertion sort, it is redone
+    if (file.bad() || loaded.cpu != cpuModelName() || loaded.hybridMergeThreshold < 1 || loaded.simdMergeThreshold < 1 ||
+        loaded.simdMergeThreshold > SIMD_BLOCK_SIZE)
+        return false;
+
+    profile = loaded;
+    return true;
+}
+
+bool saveThresholdProfile(const string& path, const ThresholdProfile& profile) {
+    ofstream file(path);
+    if (!file.is_open()) {
+        cerr << "Error: Could not open file '" << path << "'" << endl;
+        return false;
+    }
+    file << "cpu " << profile.cpu << "\n";
+    file << "hybridMergeThreshold " << profile.hybridMergeThreshold << "\n";
+    file << "simdMergeThreshold " << profile.simdMergeThreshold << "\n";
+    return file.good();
+}
+
+ThresholdProfile thresholdProfile(const string& path, bool calibrate) {
+    ThresholdProfile profile;
+    if (loadThresholdProfile(path, profile) || !calibrate)
+        return profile;
+
+    cout << "No threshold profile for this CPU in " << path << ", calibrating" << endl;
+    profile = calibrateThresholds();
+    saveThresholdProfile(path, profile);
+    return profile;
+}
@@ -0,0 +1,34 @@
+#ifndef THRESHOLD_TUNING_H
+#define THRESHOLD_TUNING_H
+
+#include <string>
+#include <vector>
+
+const std::string THRESHOLD_PROFILE_FILE = "threshold_profile.txt";
+// insertion sort cutoffs tried by the calibration, the SIMD sort only tries the ones up to SIMD_BLOCK_SIZE
+const std::vector<int> CANDIDATE_THRESHOLDS = {4, 8, 12, 16, 24, 32, 48, 64, 96, 128};
+// random inputs the cutoffs are timed on, small ones are run more often so every size weighs about the same
+const std::vector<int> CALIBRATION_SIZES = {10000, 100000, 1000000};
+
+// best insertion sort cutoffs found on one CPU, the defaults are what the sorts used before calibration
+struct ThresholdProfile {
+    std::string cpu = "";
+    int hybridMergeThreshold = 32;
+    int simdMergeThreshold = 16;
+};
+
+// name of the CPU a profile is valid for, "unknown" where it cannot be read
+std::string cpuModelName();
+
+// times hybridMergeSort (buffered) and simdHybridMergeSort with every candidate cutoff, keeps the fastest of each
+// (the SIMD base case is a sorting network of at most SIMD_BLOCK_SIZE keys, so only cutoffs up to it are tried)
+ThresholdProfile calibrateThresholds();
+
+// false if the file is missing, unreadable, was calibrated on another CPU or has a SIMD cutoff above SIMD_BLOCK_SIZE
+bool loadThresholdProfile(const std::string& path, ThresholdProfile& profile);
+bool saveThresholdProfile(const std::string& path, const ThresholdProfile& profile);
+
+// the saved profile for this CPU, calibrating and saving one first if there is none (or defaults if calibrate is false)
+ThresholdProfile thresholdProfile(const std::string& path, bool calibrate);
+
+#endif //THRESHOLD_TUNING_H
@@ -0,0 +1,113 @@
+#include "work_stealing_pool.h"
+
+using namespace std;
+
+// index of the worker running on this thread, -1 for threads outside the pool
+static thread_local int currentWorker = -1;
+
+WorkStealingPool::WorkStealingPool(unsigned threads) : stopping(false), queuedTasks(0), nextQueue(0) {
+    int workerCount = threads > 1 ? threads - 1 : 0;
+    // one extra queue receives the tasks submitted from outside the pool
+    for (int i = 0; i <= workerCount; i++)
+        queues.push_back(make_unique<WorkQueue>());
+    for (int i = 0; i < workerCount; i++)
+        workers.emplace_back(&WorkStealingPool::workerLoop, this, i);
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        lock_guard<mutex> guard(sleepLock);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    for (thread& worker : workers)
+        worker.join();
+}
+
+void WorkStealingPool::submit(function<void()> task) {
+    int index = currentWorker >= 0 ? currentWorker : (int) queues.size() - 1;
+    {
+        lock_guard<mutex> guard(queues[index]->lock);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+    queuedTasks++;
+    // taking the sleep lock makes sure a worker checking queuedTasks cannot miss this notification
+    { lock_guard<mutex> guard(sleepLock); }
+    wakeUp.notify_one();
+}
+
+// newest task of our own queue - it is the smallest and its data is still in cache
+bool WorkStealingPool::popTask(int index, function<void()>& task) {
+    WorkQueue& queue = *queues[index];
+    lock_guard<mutex> guard(queue.lock);
+    if (queue.tasks.empty()) return false;
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    queuedTasks--;
+    return true;
+}
+
+// oldest task of another queue - it is the biggest so a steal is worth its cost
+bool WorkStealingPool::stealTask(int thief, function<void()>& task) {
+    int n = queues.size();
+    int start = nextQueue++ % n;
+    for (int i = 0; i < n; i++) {
+        int victim = (start + i) % n;
+        if (victim == thief) continue;
+        WorkQueue& queue = *queues[victim];
+        lock_guard<mutex> guard(queue.lock);
+        if (queue.tasks.empty()) continue;
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        queuedTasks--;
+        return true;
+    }
+    return false;
+}
+
+bool WorkStealingPool::runPendingTask() {
+    function<void()> task;
+    if ((currentWorker >= 0 && popTask(currentWorker, task)) || stealTask(currentWorker, task)) {
+        task();
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingPool::workerLoop(int index) {
+    currentWorker = index;
+    while (true) {
+        if (runPendingTask()) continue;
+
+        unique_lock<mutex> guard(sleepLock);
+        wakeUp.wait(guard, [this] { return stopping || queuedTasks > 0; });
+        if (stopping) return;
+    }
+}
+
+int WorkStealingPool::threadCount() {
+    return workers.size() + 1;
+}
+
+WorkStealingPool& WorkStealingPool::shared() {
+    static WorkStealingPool pool;
+    return pool;
+}
+
+TaskGroup::TaskGroup(WorkStealingPool& pool) : pool(pool), pending(0) {}
+
+void TaskGroup::run(function<void()> task) {
+    pending++;
+    pool.submit([this, task = std::move(task)] {
+        task();
+        pending--;
+    });
+}
+
+void TaskGroup::wait() {
+    // help instead of blocking, otherwise nested groups could wait on tasks nobody is left to run
+    while (pending > 0) {
+        if (!pool.runPendingTask())
+            this_thread::yield();
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Thread pool where every worker owns a deque: it pushes and pops its own tasks at the back (newest first)
+// and steals from the front of the other deques (oldest = biggest subranges) when it runs dry
+class WorkStealingPool {
+private:
+    struct WorkQueue {
+        std::mutex lock;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<bool> stopping;
+    std::atomic<int> queuedTasks;
+    std::atomic<unsigned> nextQueue;
+    std::mutex sleepLock;
+    std::condition_variable wakeUp;
+
+    bool popTask(int index, std::function<void()>& task);
+    bool stealTask(int thief, std::function<void()>& task);
+    void workerLoop(int index);
+
+public:
+    // the thread that waits on the work also runs tasks, so by default one worker less than the core count
+    explicit WorkStealingPool(unsigned threads = std::thread::hardware_concurrency());
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    void submit(std::function<void()> task);
+    bool runPendingTask();
+    int threadCount();
+
+    static WorkStealingPool& shared();
+};
+
+// Fork-join helper: run() hands tasks to the pool and wait() keeps running queued tasks until all of them finished
+class TaskGroup {
+private:
+    WorkStealingPool& pool;
+    std::atomic<int> pending;
+
+public:
+    explicit TaskGroup(WorkStealingPool& pool);
+
+    void run(std::function<void()> task);
+    void wait();
+};
+
+#endif //WORK_STEALING_POOL_H
@@ -0,0 +1,185 @@
+#include "benchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <random>
+
+using namespace std;
+
+const char* distributionName(InputDistribution distribution) {
+    switch (distribution) {
+        case RANDOM_INPUT: return "random";
+        case SORTED_INPUT: return "sorted";
+        case REVERSED_INPUT: return "reversed";
+        case FEW_UNIQUE_INPUT: return "few-unique";
+        case ORGAN_PIPE_INPUT: return "organ-pipe";
+        case ZIPF_INPUT: return "zipf";
+    }
+    return "unknown";
+}
+
+// the same seed always gives the same input, so every case of a size and distribution sorts identical data
+vector<int> generateInput(InputDistribution distribution, int size, unsigned seed) {
+    mt19937 engine(seed);
+    vector<int> input(size);
+
+    switch (distribution) {
+        case RANDOM_INPUT:
+            // non-negative like rand()
+            for (int i = 0; i < size; i++)
+                input[i] = engine() >> 1;
+            break;
+        case SORTED_INPUT:
+            for (int i = 0; i < size; i++)
+                input[i] = i;
+            break;
+        case REVERSED_INPUT:
+            for (int i = 0; i < size; i++)
+                input[i] = size - i;
+            break;
+        case FEW_UNIQUE_INPUT:
+            for (int i = 0; i < size; i++)
+                input[i] = engine() % FEW_UNIQUE_VALUES;
+            break;
+        case ORGAN_PIPE_INPUT:
+            // ascending to the middle, then descending
+            for (int i = 0; i < size; i++)
+                input[i] = i < size / 2 ? i : size - i;
+            break;
+        case ZIPF_INPUT: {
+            // rank r is drawn with probability proportional to 1/r, found by binary search in the cumulative weights
+            vector<double> cumulative(ZIPF_RANKS);
+            double sum = 0;
+            for (int r = 0; r < ZIPF_RANKS; r++) {
+                sum += 1.0 / (r + 1);
+                cumulative[r] = sum;
+            }
+            uniform_real_distribution<double> uniform(0, sum);
+            for (int i = 0; i < size; i++) {
+                int rank = lower_bound(cumulative.begin(), cumulative.end(), uniform(engine)) - cumulative.begin();
+                input[i] = min(rank, ZIPF_RANKS - 1);
+            }
+            break;
+        }
+    }
+    return input;
+}
+
+static double runOnce(const BenchmarkCase& benchmarkCase, const vector<int>& input, vector<int>& work) {
+    // copying the input is not part of the measurement
+    copy(input.begin(), input.end(), work.begin());
+    auto start = chrono::steady_clock::now();
+    benchmarkCase.run(work.data(), work.size());
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+// nearest rank percentile of sorted samples
+static double percentile(const vector<double>& samples, double p) {
+    int rank = (int) ceil(p * samples.size());
+    return samples[max(rank, 1) - 1];
+}
+
+BenchmarkResult runBenchmark(const BenchmarkCase& benchmarkCase, const vector<int>& input,
+                             InputDistribution distribution, const BenchmarkOptions& options) {
+    vector<int> work(input.size());
+
+    // warmup runs fault in the pages, fill the caches and train the branch predictors; the first one also checks the output
+    bool correct = true;
+    double warmupMs = 0;
+    for (int i = 0; i < max(options.warmupRuns, 1); i++) {
+        warmupMs = runOnce(benchmarkCase, input, work);
+        if (i == 0)
+            correct = is_sorted(work.begin(), work.end());
+    }
+
+    int trials = options.trials;
+    if (warmupMs > 0)
+        trials = min(trials, max(1, (int) (options.timeBudgetMs / warmupMs)));
+
+    vector<double> samples;
+    for (int i = 0; i < trials; i++)
+        samples.push_back(runOnce(benchmarkCase, input, work));
+    sort(samples.begin(), samples.end());
+
+    double total = 0;
+    for (double sample : samples)
+        total += sample;
+
+    BenchmarkResult result;
+    result.algorithm = benchmarkCase.name;
+    result.distribution = distributionName(distribution);
+    result.size = input.size();
+    result.trials = trials;
+    result.medianMs = samples.size() % 2 ? samples[samples.size() / 2]
+                                         : (samples[samples.size() / 2 - 1] + samples[samples.size() / 2]) / 2;
+    result.p95Ms = percentile(samples, 0.95);
+    result.meanMs = total / samples.size();
+    result.minMs = samples.front();
+    result.correct = correct;
+    return result;
+}
+
+vector<BenchmarkResult> runBenchmarks(const vector<BenchmarkCase>& cases, const vector<int>& sizes,
+                                      const vector<InputDistribution>& distributions,
+                                      const BenchmarkOptions& options) {
+    vector<BenchmarkResult> results;
+    for (int size : sizes) {
+        for (InputDistribution distribution : distributions) {
+            cout << "Testing size: " << size << " (" << distributionName(distribution) << ")" << endl;
+            vector<int> input = generateInput(distribution, size, options.seed + size);
+
+            for (const BenchmarkCase& benchmarkCase : cases) {
+                BenchmarkResult result = runBenchmark(benchmarkCase, input, distribution, options);
+                printResult(result);
+                results.push_back(result);
+            }
+            cout << endl;
+        }
+    }
+    return results;
+}
+
+void printResult(const BenchmarkResult& result) {
+    printf("Running time for %s is %f ms (median of %d, p95 %f ms)", result.algorithm.c_str(), result.medianMs,
+           result.trials, result.p95Ms);
+    if (!result.correct)
+        printf(" - OUTPUT NOT SORTED");
+    printf("\n");
+}
+
+// one row per algorithm, distribution and size - the SortingGraph charts plot median_ms against size per algorithm
+void writeResultsCsv(const vector<BenchmarkResult>& results, const string& path) {
+    ofstream out(path);
+    if (!out) {
+        cerr << "Error: Could not open file '" << path << "'" << endl;
+        return;
+    }
+    out << "algorithm,distribution,size,trials,median_ms,p95_ms,mean_ms,min_ms,correct\n";
+    for (const BenchmarkResult& result : results) {
+        out << "\"" << result.algorithm << "\"," << result.distribution << "," << result.size << ","
+            << result.trials << "," << result.medianMs << "," << result.p95Ms << "," << result.meanMs << ","
+            << result.minMs << "," << (result.correct ? "true" : "false") << "\n";
+    }
+}
+
+void writeResultsJson(const vector<BenchmarkResult>& results, const string& path) {
+    ofstream out(path);
+    if (!out) {
+        cerr << "Error: Could not open file '" << path << "'" << endl;
+        return;
+    }
+    out << "[\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchmarkResult& result = results[i];
+        out << "  {\"algorithm\": \"" << result.algorithm << "\", \"distribution\": \"" << result.distribution
+            << "\", \"size\": " << result.size << ", \"trials\": " << result.trials
+            << ", \"median_ms\": " << result.medianMs << ", \"p95_ms\": " << result.p95Ms
+            << ", \"mean_ms\": " << result.meanMs << ", \"min_ms\": " << result.minMs
+            << ", \"correct\": " << (result.correct ? "true" : "false") << "}"
+            << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "]\n";
+}
@@ -0,0 +1,58 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+enum InputDistribution { RANDOM_INPUT, SORTED_INPUT, REVERSED_INPUT, FEW_UNIQUE_INPUT, ORGAN_PIPE_INPUT, ZIPF_INPUT };
+
+const std::vector<InputDistribution> ALL_DISTRIBUTIONS = {
+    RANDOM_INPUT, SORTED_INPUT, REVERSED_INPUT, FEW_UNIQUE_INPUT, ORGAN_PIPE_INPUT, ZIPF_INPUT
+};
+
+// distinct keys in a few unique input
+const int FEW_UNIQUE_VALUES = 16;
+// Zipf inputs draw their keys from this many ranks with exponent 1
+const int ZIPF_RANKS = 1 << 20;
+
+// one algorithm under test, run() gets a copy of the input every trial
+struct BenchmarkCase {
+    std::string name;
+    std::function<void(int[], int)> run;
+};
+
+struct BenchmarkOptions {
+    int warmupRuns = 1;
+    int trials = 5;
+    // slow cases run fewer trials so that one case takes about this long (but always at least one trial)
+    double timeBudgetMs = 5000;
+    unsigned seed = 42;
+};
+
+struct BenchmarkResult {
+    std::string algorithm;
+    std::string distribution;
+    int size;
+    int trials;
+    double medianMs;
+    double p95Ms;
+    double meanMs;
+    double minMs;
+    bool correct;
+};
+
+const char* distributionName(InputDistribution distribution);
+std::vector<int> generateInput(InputDistribution distribution, int size, unsigned seed);
+
+BenchmarkResult runBenchmark(const BenchmarkCase& benchmarkCase, const std::vector<int>& input,
+                             InputDistribution distribution, const BenchmarkOptions& options);
+std::vector<BenchmarkResult> runBenchmarks(const std::vector<BenchmarkCase>& cases, const std::vector<int>& sizes,
+                                           const std::vector<InputDistribution>& distributions,
+                                           const BenchmarkOptions& options);
+
+void printResult(const BenchmarkResult& result);
+void writeResultsCsv(const std::vector<BenchmarkResult>& results, const std::string& path);
+void writeResultsJson(const std::vector<BenchmarkResult>& results, const std::string& path);
+
+#endif //BENCHMARK_H
@@ -1,27 +1,24 @@
 #include <iostream>
-#include <ctime>
-#include <cstdlib>
+#include "benchmark.h"
 
 using namespace std;
 
+const string RESULTS_CSV = "sorting_results.csv";
+const string RESULTS_JSON = "sorting_results.json";
+
 void bubbleSort(int arr[], int size);
 void selectionSort(int arr[], int size);
 void insertionSort(int arr[], int size);
 
-int* generateRandArray(int size);
-void measureRuntime(int size);
+vector<BenchmarkCase> sortingCases();
 
 int main() {
-    // seed random number generator to get different random numbers each time
-    srand(time(nullptr));
-
-    int testSizes[] = {1000, 10000, 25000, 50000, 75000, 100000};
+    vector<int> testSizes = {1000, 10000, 25000, 50000, 75000, 100000};
+    vector<BenchmarkResult> results = runBenchmarks(sortingCases(), testSizes, ALL_DISTRIBUTIONS, BenchmarkOptions());
 
-    for (int size : testSizes) {
-        cout << "Testing size: " << size << endl;
-        measureRuntime(size);
-        cout << endl;
-    }
+    writeResultsCsv(results, RESULTS_CSV);
+    writeResultsJson(results, RESULTS_JSON);
+    cout << "Results written to " << RESULTS_CSV << " and " << RESULTS_JSON << endl;
 
     return 0;
 }
@@ -68,46 +65,10 @@ void insertionSort(int arr[], int size) {
     }
 }
 
-int* generateRandArray(int size) {
-    int* arr = new int[size];
-
-    for (int i = 0; i < size; i++)
-        arr[i] = rand();
-
-    return arr;
-}
-
-void measureRuntime(int size) {
-    clock_t start, end;
-    double cpu_time_used;
-
-    int* arr = generateRandArray(size);
-    int* arrCopy = new int[size];
-
-    // Bubble Sort
-    memcpy(arrCopy, arr, size * sizeof(int));
-    start = clock();
-    bubbleSort(arrCopy, size);
-    end = clock();
-    cpu_time_used = (((double)(end - start)) / CLOCKS_PER_SEC) * 1000;
-    printf("Running time for Bubble Sort is %f ms\n", cpu_time_used);
-
-    // Selection Sort
-    memcpy(arrCopy, arr, size * sizeof(int));
-    start = clock();
-    selectionSort(arrCopy, size);
-    end = clock();
-    cpu_time_used = (((double) (end - start)) / CLOCKS_PER_SEC) * 1000;
-    printf("Running time for Selection Sort is %f ms\n", cpu_time_used);
-
-    // Insertion Sort
-    memcpy(arrCopy, arr, size * sizeof(int));
-    start = clock();
-    insertionSort(arrCopy, size);
-    end = clock();
-    cpu_time_used = (((double) (end - start)) / CLOCKS_PER_SEC) * 1000;
-    printf("Running time for Insertion Sort is %f ms\n", cpu_time_used);
-
-    delete[] arr;
-    delete[] arrCopy;
+vector<BenchmarkCase> sortingCases() {
+    vector<BenchmarkCase> cases;
+    cases.push_back({"Bubble Sort", [](int arr[], int size) { bubbleSort(arr, size); }});
+    cases.push_back({"Selection Sort", [](int arr[], int size) { selectionSort(arr, size); }});
+    cases.push_back({"Insertion Sort", [](int arr[], int size) { insertionSort(arr, size); }});
+    return cases;
 }